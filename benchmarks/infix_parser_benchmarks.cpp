@@ -0,0 +1,68 @@
+/**
+ * @file	infix_parser_benchmarks.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/26
+ */
+
+/* -- Includes -- */
+
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "infix_parser.hpp"
+#include "lexical_analyzer.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace benchmark;
+using namespace lexer;
+
+/* -- Constants -- */
+
+namespace
+{
+
+  /** Number of operands in each generated expression. */
+  const int term_count = 1000000;
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Benchmarks lexing and parsing the specified input. */
+  void parse_infix(State& state, const string& input)
+  {
+    for (auto _ : state)
+    {
+      lexical_analyzer lex(input);
+      infix_parser parser(lex);
+      while (auto expr = parser.next_expression())
+        DoNotOptimize(expr);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+  }
+
+}
+
+/* -- Benchmarks -- */
+
+/** Parses a long chain of alternating operators: 0 + 1 * 2 + 3 ... */
+void infix_long_chain(State& state)
+{
+  string input = "0";
+  for (int idx = 1; idx < term_count; idx++)
+    input += (idx % 2 ? " + " : " * ") + to_string(idx);
+  parse_infix(state, input);
+}
+BENCHMARK(infix_long_chain)->Unit(kMillisecond);
+
+/** Parses a single operand inside deeply nested brackets: (((...1...))) */
+void infix_deep_brackets(State& state)
+{
+  parse_infix(state, string(term_count, '(') + "1" + string(term_count, ')'));
+}
+BENCHMARK(infix_deep_brackets)->Unit(kMillisecond);
@@ -0,0 +1,14 @@
+/* -- Includes -- */
+
+#include <benchmark/benchmark.h>
+
+/* -- Procedures -- */
+
+int main(int argc, char** argv)
+{
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file	pipelined_parser_benchmarks.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/22
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "expression.hpp"
+#include "lexical_analyzer.hpp"
+#include "pipelined_parser.hpp"
+#include "syntax_analyzer.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace benchmark;
+using namespace lexer;
+
+/* -- Constants -- */
+
+namespace
+{
+
+  /** Number of top-level expressions in the generated input. */
+  const size_t expression_count = 20000;
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns an input of many small top-level expressions. */
+  string make_input()
+  {
+    string input;
+    for (size_t idx = 0; idx < expression_count; idx++)
+      input += "(" + to_string(idx) + " + (2 * " + to_string(idx % 97) + "))\n";
+    return input;
+  }
+
+  /** Evaluates an expression, standing in for the work a consumer does with it. */
+  int evaluate(const expression& expr)
+  {
+    if (expr.type() == expression_type::simple)
+      return static_cast<const simple_expression&>(expr).value();
+
+    const auto& compound = static_cast<const compound_expression&>(expr);
+    auto left = evaluate(*compound.left_expression());
+    auto right = evaluate(*compound.right_expression());
+    switch (compound.operator_type())
+    {
+    case operator_type::addition:
+      return left + right;
+    case operator_type::subtraction:
+      return left - right;
+    case operator_type::multiplication:
+      return left * right;
+    case operator_type::division:
+      return (right == 0 ? 0 : left / right);
+    }
+    return 0;
+  }
+
+}
+
+/* -- Benchmarks -- */
+
+/** Lexes, parses and evaluates an input one expression at a time, as `parse_string` does. */
+void pipeline_serial(State& state)
+{
+  auto input = make_input();
+  for (auto _ : state)
+  {
+    int total = 0;
+    lexical_analyzer lex(input);
+    syntax_analyzer syn(lex);
+    while (auto expr = syn.next_expression())
+      total += evaluate(*expr);
+    DoNotOptimize(total);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(pipeline_serial)->Unit(kMillisecond)->UseRealTime();
+
+/** Lexes, parses and evaluates an input with the stages overlapped on three threads. */
+void pipeline_pipelined(State& state)
+{
+  auto input = make_input();
+  for (auto _ : state)
+  {
+    int total = 0;
+    parse_pipelined(input, [&] (unique_ptr<const expression> expr) {
+        total += evaluate(*expr);
+      });
+    DoNotOptimize(total);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(pipeline_pipelined)->Unit(kMillisecond)->UseRealTime();
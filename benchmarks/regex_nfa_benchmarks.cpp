@@ -0,0 +1,93 @@
+/**
+ * @file	regex_nfa_benchmarks.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/16
+ */
+
+/* -- Includes -- */
+
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "regex_nfa.hpp"
+#include "regex_options.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace benchmark;
+using namespace lexer;
+
+/* -- Constants -- */
+
+namespace
+{
+
+  /** Number of characters in each generated regular expression. */
+  const size_t pattern_length = 100000;
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns `count` copies of `str`. */
+  string repeat_string(const string& str, size_t count)
+  {
+    string result;
+    for (size_t idx = 0; idx < count; idx++)
+      result += str;
+    return result;
+  }
+
+  /** Returns options allowing NFAs large enough for the generated regular expressions. */
+  regex_options large_options()
+  {
+    regex_options options;
+    options.max_fragments = pattern_length * 4;
+    return options;
+  }
+
+  /** Benchmarks building the NFA for the specified regular expression. */
+  void build_nfa(State& state, const string& regex)
+  {
+    auto options = large_options();
+    for (auto _ : state)
+      DoNotOptimize(regex_to_nfa(regex, options));
+    state.SetBytesProcessed(state.iterations() * regex.size());
+  }
+
+}
+
+/* -- Benchmarks -- */
+
+/** Builds an NFA for a long sequence of literals: abcabc... */
+void regex_nfa_concatenation(State& state)
+{
+  build_nfa(state, repeat_string("abc", pattern_length / 3));
+}
+BENCHMARK(regex_nfa_concatenation)->Unit(kMillisecond);
+
+/** Builds an NFA for a long alternation: a|b|a|b... */
+void regex_nfa_alternation(State& state)
+{
+  build_nfa(state, "a" + repeat_string("|b", pattern_length / 2));
+}
+BENCHMARK(regex_nfa_alternation)->Unit(kMillisecond);
+
+/** Builds an NFA for a long sequence of optional and repeated literals: a?b*c+a?b*c+... */
+void regex_nfa_quantifiers(State& state)
+{
+  build_nfa(state, repeat_string("a?b*c+", pattern_length / 6));
+}
+BENCHMARK(regex_nfa_quantifiers)->Unit(kMillisecond);
+
+/** Builds an NFA for deeply nested groups: ((((a)*b)*c)*... */
+void regex_nfa_nesting(State& state)
+{
+  auto count = pattern_length / 5;
+  build_nfa(state, string(count, '(') + "a" + repeat_string(")*b", count));
+}
+BENCHMARK(regex_nfa_nesting)->Unit(kMillisecond);
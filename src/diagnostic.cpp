@@ -0,0 +1,77 @@
+/**
+ * @file	diagnostic.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/24
+ */
+
+/* -- Includes -- */
+
+#include <sstream>
+#include <string>
+
+#include "diagnostic.hpp"
+#include "lexical_analyzer.hpp"
+#include "syntax_analyzer.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns a message for a problem in a regular expression, in the same form as the parser's. */
+  string regex_message(const string& problem, size_t pos)
+  {
+    ostringstream message;
+    message << problem << " at position " << pos << "!";
+    return message.str();
+  }
+
+}
+
+/* -- Procedures -- */
+
+string lexer::diagnostic_message(const diagnostic& diag, const string& input)
+{
+  switch (diag.kind)
+  {
+  case diagnostic_kind::invalid_token:
+    return invalid_token_error(diag.line_number, diag.column_number).what();
+  case diagnostic_kind::unexpected_token:
+    return parse_error(input.substr(diag.offset, diag.length),
+                       diag.line_number,
+                       diag.column_number).what();
+  case diagnostic_kind::regex_empty_alternative:
+    return regex_message("Empty alternative", diag.offset);
+  case diagnostic_kind::regex_unmatched_open_bracket:
+    return regex_message("Unmatched open bracket", diag.offset);
+  case diagnostic_kind::regex_unmatched_close_bracket:
+    return regex_message("Unmatched close bracket", diag.offset);
+  case diagnostic_kind::regex_nothing_to_repeat:
+    return regex_message("Nothing to repeat", diag.offset);
+  case diagnostic_kind::regex_dangling_escape:
+    return regex_message("Dangling escape", diag.offset);
+  case diagnostic_kind::regex_invalid_hex_escape:
+    return regex_message("Invalid hexadecimal escape", diag.offset);
+  case diagnostic_kind::regex_unterminated_class:
+    return regex_message("Unterminated character class", diag.offset);
+  case diagnostic_kind::regex_invalid_class_range:
+    return regex_message("Invalid character class range", diag.offset);
+  case diagnostic_kind::regex_empty_class:
+    return regex_message("Empty character class", diag.offset);
+  case diagnostic_kind::regex_invalid_utf8:
+    return regex_message("Invalid UTF-8 sequence", diag.offset);
+  case diagnostic_kind::regex_invalid_repetition:
+    return regex_message("Invalid repetition operator", diag.offset);
+  case diagnostic_kind::regex_repetition_too_large:
+    return regex_message("Repetition count is too large", diag.offset);
+  case diagnostic_kind::regex_too_large:
+    return "Regular expression is too large!";
+  default:
+    return "Unknown problem.";
+  }
+}
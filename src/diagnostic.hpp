@@ -0,0 +1,80 @@
+/**
+ * @file	diagnostic.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/24
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <string>
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Enumeration of the kinds of problem found in an input.
+   */
+  enum class diagnostic_kind
+  {
+    invalid_token,
+    unexpected_token,
+    regex_empty_alternative,
+    regex_unmatched_open_bracket,
+    regex_unmatched_close_bracket,
+    regex_nothing_to_repeat,
+    regex_dangling_escape,
+    regex_invalid_hex_escape,
+    regex_unterminated_class,
+    regex_invalid_class_range,
+    regex_empty_class,
+    regex_invalid_utf8,
+    regex_invalid_repetition,
+    regex_repetition_too_large,
+    regex_too_large,
+  };
+
+  /**
+   * Struct representing a problem found in an input, which was skipped rather than thrown.
+   *
+   * Diagnostics only record where the problem is. The message is formatted on demand by
+   * `lexer::diagnostic_message`, since most callers only count or locate them.
+   */
+  struct diagnostic
+  {
+
+    /** The kind of problem. */
+    lexer::diagnostic_kind kind;
+
+    /** The offset of the problem in the input. */
+    std::size_t offset;
+
+    /** The number of characters involved, e.g. the length of the unexpected token. */
+    std::size_t length;
+
+    /** The line number of the problem. This is always 0 for regular expressions. */
+    int line_number;
+
+    /** The column number of the problem. This is the offset for regular expressions. */
+    int column_number;
+
+  };
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Returns a message describing a diagnostic in the specified input, in the same form as the
+   * message of the corresponding exception.
+   */
+  std::string diagnostic_message(const lexer::diagnostic& diag, const std::string& input);
+
+}
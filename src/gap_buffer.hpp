@@ -0,0 +1,172 @@
+/**
+ * @file	gap_buffer.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing a sequence with a movable gap, for sequences which are edited repeatedly
+   * in the same area, e.g. the tokens of a buffer being typed into.
+   *
+   * Inserting or removing elements at the gap only touches those elements, and moving the gap
+   * only touches the elements it moves past, so a run of nearby edits costs nothing in proportion
+   * to the length of the sequence.
+   *
+   * The owner may store the elements after the gap relative to something which changes with each
+   * edit (e.g. token offsets which are shifted by a single running delta on access), so that edits
+   * do not have to update them. `move_gap` reports each element which crosses the gap so that it
+   * can be converted.
+   */
+  template <typename T>
+  class gap_buffer
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new, empty `lexer::gap_buffer`. */
+    gap_buffer()
+      : m_items(),
+        m_gap_begin(0),
+        m_gap_end(0)
+    { }
+
+    /** Constructs a new `lexer::gap_buffer` with the specified elements, and the gap at the end. */
+    explicit gap_buffer(std::vector<T> items)
+      : m_items(std::move(items)),
+        m_gap_begin(m_items.size()),
+        m_gap_end(m_items.size())
+    { }
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the number of elements. */
+    std::size_t size() const
+    {
+      return m_items.size() - (m_gap_end - m_gap_begin);
+    }
+
+    /** Returns the index of the first element after the gap. */
+    std::size_t gap() const
+    {
+      return m_gap_begin;
+    }
+
+    /** Returns the element at the specified index. */
+    T& operator[](std::size_t index)
+    {
+      return m_items[index < m_gap_begin ? index : index + (m_gap_end - m_gap_begin)];
+    }
+
+    /** Returns the element at the specified index. */
+    const T& operator[](std::size_t index) const
+    {
+      return m_items[index < m_gap_begin ? index : index + (m_gap_end - m_gap_begin)];
+    }
+
+    /**
+     * Moves the gap to just before the element at the specified index. Each element which crosses
+     * the gap is passed to `crossed`, along with `true` if it is now before the gap.
+     */
+    template <typename crossed_fn>
+    void move_gap(std::size_t index, crossed_fn crossed)
+    {
+      // with no gap, the elements are already where they need to be
+      auto empty = (m_gap_begin == m_gap_end);
+      while (m_gap_begin > index)
+      {
+        --m_gap_begin;
+        --m_gap_end;
+        if (!empty)
+          m_items[m_gap_end] = std::move(m_items[m_gap_begin]);
+        crossed(m_items[m_gap_end], false);
+      }
+      while (m_gap_begin < index)
+      {
+        if (!empty)
+          m_items[m_gap_begin] = std::move(m_items[m_gap_end]);
+        crossed(m_items[m_gap_begin], true);
+        ++m_gap_begin;
+        ++m_gap_end;
+      }
+    }
+
+    /** Removes the specified number of elements from just before the gap. */
+    void erase_before_gap(std::size_t count)
+    {
+      for (; count > 0; count--)
+        m_items[--m_gap_begin] = T();
+    }
+
+    /** Inserts an element just before the gap. */
+    void insert_before_gap(T item)
+    {
+      if (m_gap_begin == m_gap_end)
+        grow();
+      m_items[m_gap_begin++] = std::move(item);
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    /** Doubles the capacity of the buffer, widening the gap. */
+    void grow()
+    {
+      auto after = m_items.size() - m_gap_end;
+      std::vector<T> items(std::max<std::size_t>(16, m_items.size() * 2));
+      std::move(m_items.begin(), m_items.begin() + m_gap_begin, items.begin());
+      std::move(m_items.begin() + m_gap_end, m_items.end(), items.end() - after);
+      m_gap_end = items.size() - after;
+      m_items = std::move(items);
+    }
+
+    std::vector<T> m_items;
+    std::size_t m_gap_begin;
+    std::size_t m_gap_end;
+
+  };
+
+}
+
+/* -- Procedures -- */
+
+namespace lexer
+{
+
+  /**
+   * Returns the first index in `[first, last)` for which `pred` returns `false`, or `last` if
+   * there is none. `pred` must return `true` for every index before that one.
+   */
+  template <typename predicate_fn>
+  std::size_t partition_index(std::size_t first, std::size_t last, predicate_fn pred)
+  {
+    while (first < last)
+    {
+      auto middle = first + (last - first) / 2;
+      if (pred(middle))
+        first = middle + 1;
+      else
+        last = middle;
+    }
+    return first;
+  }
+
+}
@@ -0,0 +1,191 @@
+/**
+ * @file	incremental_lexer.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+/* -- Includes -- */
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gap_buffer.hpp"
+#include "incremental_lexer.hpp"
+#include "lexical_analyzer.hpp"
+#include "token.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns the offset just past the end of a token. */
+  size_t token_end(const token& tok)
+  {
+    return tok.offset() + tok.lexeme().size();
+  }
+
+  /** Returns the location just past the end of a token. Tokens never span lines. */
+  source_location token_end_location(const token& tok)
+  {
+    source_location location;
+    location.offset = token_end(tok);
+    location.line_number = tok.line_number();
+    location.column_number = tok.column_number() + static_cast<int>(tok.lexeme().size());
+    return location;
+  }
+
+}
+
+/* -- Procedures -- */
+
+incremental_lexer::incremental_lexer(string input)
+  : m_input(move(input)),
+    m_tokens(),
+    m_offset_delta(0),
+    m_line_delta(0)
+{
+  vector<token> tokens;
+  source_location location;
+  do
+    tokens.push_back(read_token(m_input, location));
+  while (tokens.back().type() != token_type::eof);
+  m_tokens = gap_buffer<token>(move(tokens));
+}
+
+token incremental_lexer::token_at(size_t index) const
+{
+  auto tok = m_tokens[index];
+  if (index >= m_tokens.gap())
+  {
+    tok.set_offset(tok.offset() + m_offset_delta);
+    tok.set_line_number(tok.line_number() + m_line_delta);
+  }
+  return tok;
+}
+
+vector<token> incremental_lexer::tokens() const
+{
+  vector<token> tokens;
+  tokens.reserve(token_count());
+  for (size_t idx = 0; idx < token_count(); idx++)
+    tokens.push_back(token_at(idx));
+  return tokens;
+}
+
+size_t incremental_lexer::offset_at(size_t index) const
+{
+  return m_tokens[index].offset() + (index >= m_tokens.gap() ? m_offset_delta : 0);
+}
+
+token_change incremental_lexer::apply(const text_edit& edit)
+{
+  if (edit.offset > m_input.size() || edit.removed > m_input.size() - edit.offset)
+    throw out_of_range("Edit extends beyond the end of the input!");
+
+  // a token depends on the characters up to and including the one after it, so the first token
+  // which can change is the first one reaching the edit - the `eof` token always does
+  auto first = partition_index(0, token_count(), [&] (size_t idx) {
+      return offset_at(idx) + m_tokens[idx].lexeme().size() < edit.offset;
+    });
+
+  // tokens starting after the removed text are candidates for resynchronizing
+  auto edit_end = edit.offset + edit.removed;
+  auto resync = partition_index(first, token_count(), [&] (size_t idx) {
+      return offset_at(idx) < edit_end;
+    });
+
+  // re-lex the edited input from the end of the last unaffected token, restoring the input if
+  // there is an invalid token - offsets wrap around if the input shrinks, which is harmless
+  auto old_size = m_input.size();
+  auto removed = m_input.substr(edit.offset, edit.removed);
+  m_input.replace(edit.offset, edit.removed, edit.inserted);
+  auto offset_delta = m_input.size() - old_size;
+  auto shift = [&] (size_t offset) { return offset + offset_delta; };
+
+  vector<token> inserted;
+  token old_resync;
+  token new_resync;
+  try
+  {
+    auto location = (first == 0 ? source_location() : token_end_location(token_at(first - 1)));
+    while (true)
+    {
+      auto tok = read_token(m_input, location);
+      while (resync < token_count() && shift(offset_at(resync)) < tok.offset())
+        resync++;
+
+      // the text from an old token onwards is unchanged, so the rest of the tokens are too - the
+      // last token is `eof`, so this always happens eventually
+      if (resync < token_count() && shift(offset_at(resync)) == tok.offset())
+      {
+        old_resync = token_at(resync);
+        new_resync = move(tok);
+        break;
+      }
+
+      inserted.push_back(move(tok));
+    }
+  }
+  catch (...)
+  {
+    m_input.replace(edit.offset, edit.inserted.size(), removed);
+    throw;
+  }
+
+  // the tokens just before the edit were only re-lexed in case they ran into it, so drop any which
+  // turned out the same, to keep the change as small as possible
+  size_t same = 0;
+  while (same < inserted.size() && first + same < resync)
+  {
+    auto old = token_at(first + same);
+    if (inserted[same].type() != old.type() ||
+        inserted[same].offset() != old.offset() ||
+        inserted[same].lexeme() != old.lexeme())
+      break;
+    same++;
+  }
+  first += same;
+
+  // move the gap to the resync point, converting the tokens which cross it with the old deltas,
+  // and replace the changed tokens before it
+  m_tokens.move_gap(resync, [&] (token& tok, bool before) {
+      if (before)
+      {
+        tok.set_offset(tok.offset() + m_offset_delta);
+        tok.set_line_number(tok.line_number() + m_line_delta);
+      }
+      else
+      {
+        tok.set_offset(tok.offset() - m_offset_delta);
+        tok.set_line_number(tok.line_number() - m_line_delta);
+      }
+    });
+  m_tokens.erase_before_gap(resync - first);
+  for (auto idx = same; idx < inserted.size(); idx++)
+    m_tokens.insert_before_gap(move(inserted[idx]));
+
+  // the tokens after the gap move by the same amounts as the resync token, and those on its line
+  // also move along it
+  m_offset_delta += offset_delta;
+  m_line_delta += new_resync.line_number() - old_resync.line_number();
+  auto column_delta = new_resync.column_number() - old_resync.column_number();
+  if (column_delta != 0)
+  {
+    auto line = new_resync.line_number() - m_line_delta;
+    for (auto idx = m_tokens.gap(); idx < token_count() && m_tokens[idx].line_number() == line; idx++)
+    {
+      auto& moved = m_tokens[idx];
+      moved.set_column_number(moved.column_number() + column_delta);
+    }
+  }
+
+  return { first, resync - first, inserted.size() - same };
+}
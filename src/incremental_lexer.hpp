@@ -0,0 +1,145 @@
+/**
+ * @file	incremental_lexer.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "gap_buffer.hpp"
+#include "token.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Struct representing an edit to a buffer: `removed` characters starting at `offset` are
+   * replaced with the `inserted` text.
+   */
+  struct text_edit
+  {
+
+    /** The offset of the first character to remove. */
+    std::size_t offset;
+
+    /** The number of characters to remove. */
+    std::size_t removed;
+
+    /** The text to insert in their place. */
+    std::string inserted;
+
+  };
+
+  /**
+   * Struct describing how an edit changed a token stream: the `removed` tokens starting at index
+   * `first` were replaced with the `inserted` tokens starting at the same index.
+   *
+   * Tokens before `first` are unchanged. Tokens after the replaced range have the same type and
+   * lexeme as before, but may have moved.
+   */
+  struct token_change
+  {
+
+    /** The index of the first token which changed. */
+    std::size_t first;
+
+    /** The number of tokens which were removed. */
+    std::size_t removed;
+
+    /** The number of tokens which were inserted in their place. */
+    std::size_t inserted;
+
+  };
+
+  /**
+   * Class maintaining the token stream for a buffer which is edited over time.
+   *
+   * Rather than lexing the whole buffer again after each edit, the lexer restarts from the last
+   * token boundary which the edit cannot affect, and stops as soon as it produces a token at the
+   * (shifted) position of a token from after the edit, since every token from there on must be
+   * the same as before.
+   *
+   * The tokens are kept in a `lexer::gap_buffer` with the gap at the last edit. The tokens after
+   * the gap store their offsets and line numbers as they were when they were moved there, and are
+   * shifted on access, so an edit only updates the tokens it replaces and those on the same line
+   * after them. Apart from the replacement of the text itself, the cost of an edit depends on its
+   * size and its distance from the previous edit, not on the size of the buffer.
+   */
+  class incremental_lexer
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /**
+     * Constructs a new `lexer::incremental_lexer` instance, lexing the whole of the input.
+     *
+     * @exception lexer::invalid_token_error
+     * Thrown if the input contains an invalid token.
+     */
+    incremental_lexer(std::string input);
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the current contents of the buffer. */
+    const std::string& input() const
+    {
+      return m_input;
+    }
+
+    /** Returns the number of tokens for the current contents of the buffer. */
+    std::size_t token_count() const
+    {
+      return m_tokens.size();
+    }
+
+    /** Returns the token at the specified index. The last token is always `eof`. */
+    lexer::token token_at(std::size_t index) const;
+
+    /**
+     * Returns a copy of all of the tokens for the current contents of the buffer, ending with an
+     * `eof` token. This takes time in proportion to the number of tokens.
+     */
+    std::vector<lexer::token> tokens() const;
+
+    /**
+     * Applies an edit to the buffer, re-lexing only as much as is needed, and returns the range of
+     * tokens which changed.
+     *
+     * @exception std::out_of_range
+     * Thrown if the edit extends beyond the end of the buffer.
+     *
+     * @exception lexer::invalid_token_error
+     * Thrown if the edited buffer contains an invalid token. The buffer and tokens are left
+     * unchanged in this case.
+     */
+    lexer::token_change apply(const lexer::text_edit& edit);
+
+    /* -- Implementation -- */
+
+  private:
+
+    /** Returns the offset of the token at the specified index. */
+    std::size_t offset_at(std::size_t index) const;
+
+    std::string m_input;
+    lexer::gap_buffer<lexer::token> m_tokens;
+
+    /** The amounts to add to the stored offsets and line numbers of the tokens after the gap. */
+    std::size_t m_offset_delta;
+    int m_line_delta;
+
+  };
+
+}
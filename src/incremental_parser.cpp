@@ -0,0 +1,151 @@
+/**
+ * @file	incremental_parser.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expression.hpp"
+#include "gap_buffer.hpp"
+#include "incremental_lexer.hpp"
+#include "incremental_parser.hpp"
+#include "syntax_analyzer.hpp"
+#include "token.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /**
+   * Parses the top-level expression at the specified token index of a lexer, advancing the index
+   * past it. Returns `false` if the index is at the `eof` token.
+   */
+  bool parse_top_level(const incremental_lexer& lex, size_t& index, parsed_expression& result)
+  {
+    // the last token is `eof`, which is returned again if the parser tries to read past it
+    auto first = index;
+    unique_ptr<const expression> expr = parse_expression([&] () {
+        return lex.token_at(index + 1 < lex.token_count() ? index++ : index);
+      });
+    if (!expr)
+      return false;
+
+    result.first_token = first;
+    result.token_count = index - first;
+    result.expr = move(expr);
+    return true;
+  }
+
+}
+
+/* -- Procedures -- */
+
+incremental_parser::incremental_parser(string input)
+  : m_lexer(move(input)),
+    m_expressions(),
+    m_token_delta(0)
+{
+  vector<parsed_expression> expressions;
+  size_t index = 0;
+  parsed_expression parsed;
+  while (parse_top_level(m_lexer, index, parsed))
+    expressions.push_back(move(parsed));
+  m_expressions = gap_buffer<parsed_expression>(move(expressions));
+}
+
+parsed_expression incremental_parser::expression_at(size_t index) const
+{
+  auto parsed = m_expressions[index];
+  parsed.first_token = first_token_at(index);
+  return parsed;
+}
+
+vector<parsed_expression> incremental_parser::expressions() const
+{
+  vector<parsed_expression> expressions;
+  expressions.reserve(expression_count());
+  for (size_t idx = 0; idx < expression_count(); idx++)
+    expressions.push_back(expression_at(idx));
+  return expressions;
+}
+
+size_t incremental_parser::first_token_at(size_t index) const
+{
+  return m_expressions[index].first_token + (index >= m_expressions.gap() ? m_token_delta : 0);
+}
+
+expression_change incremental_parser::apply(const text_edit& edit)
+{
+  if (edit.offset > input().size() || edit.removed > input().size() - edit.offset)
+    throw out_of_range("Edit extends beyond the end of the input!");
+
+  auto removed = input().substr(edit.offset, edit.removed);
+  auto change = m_lexer.apply(edit);
+
+  // an expression never looks at the tokens after it, so the first expression which can change is
+  // the first one ending after the first changed token
+  auto first = partition_index(0, expression_count(), [&] (size_t idx) {
+      return first_token_at(idx) + m_expressions[idx].token_count <= change.first;
+    });
+
+  // expressions starting after the removed tokens are candidates for resynchronizing - indices
+  // wrap around if tokens were removed, which is harmless
+  auto change_end = change.first + change.removed;
+  auto resync = partition_index(first, expression_count(), [&] (size_t idx) {
+      return first_token_at(idx) < change_end;
+    });
+  auto token_delta = change.inserted - change.removed;
+  auto shift = [&] (size_t index) { return index + token_delta; };
+
+  // re-parse from the end of the last unaffected expression until we reach an expression which
+  // starts at the (shifted) start of an old one - the tokens from there on are unchanged, so the
+  // expressions are too
+  vector<parsed_expression> inserted;
+  try
+  {
+    auto index = (first == 0 ? 0 : first_token_at(first - 1) + m_expressions[first - 1].token_count);
+    while (true)
+    {
+      while (resync < expression_count() && shift(first_token_at(resync)) < index)
+        resync++;
+      if (resync < expression_count() && shift(first_token_at(resync)) == index)
+        break;
+
+      parsed_expression parsed;
+      if (!parse_top_level(m_lexer, index, parsed))
+        break;
+      inserted.push_back(move(parsed));
+    }
+  }
+  catch (...)
+  {
+    // put the tokens back the way they were - they were valid before, so this cannot fail
+    m_lexer.apply({ edit.offset, edit.inserted.size(), removed });
+    throw;
+  }
+
+  // move the gap to the resync point, converting the expressions which cross it with the old
+  // delta, and replace the changed expressions before it
+  m_expressions.move_gap(resync, [&] (parsed_expression& parsed, bool before) {
+      parsed.first_token += (before ? m_token_delta : 0 - m_token_delta);
+    });
+  m_expressions.erase_before_gap(resync - first);
+  for (auto& parsed : inserted)
+    m_expressions.insert_before_gap(move(parsed));
+  m_token_delta += token_delta;
+
+  return { first, resync - first, inserted.size() };
+}
@@ -0,0 +1,157 @@
+/**
+ * @file	incremental_parser.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expression.hpp"
+#include "gap_buffer.hpp"
+#include "incremental_lexer.hpp"
+#include "token.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Struct representing a top-level expression and the range of tokens it was parsed from.
+   */
+  struct parsed_expression
+  {
+
+    /** The index of the expression's first token. */
+    std::size_t first_token;
+
+    /** The number of tokens in the expression. */
+    std::size_t token_count;
+
+    /** The expression itself. */
+    std::shared_ptr<const lexer::expression> expr;
+
+  };
+
+  /**
+   * Struct describing how an edit changed a list of top-level expressions: the `removed`
+   * expressions starting at index `first` were replaced with the `inserted` expressions starting
+   * at the same index.
+   */
+  struct expression_change
+  {
+
+    /** The index of the first expression which changed. */
+    std::size_t first;
+
+    /** The number of expressions which were removed. */
+    std::size_t removed;
+
+    /** The number of expressions which were inserted in their place. */
+    std::size_t inserted;
+
+  };
+
+  /**
+   * Class maintaining the top-level expressions for a buffer which is edited over time.
+   *
+   * After each edit, only the expressions whose tokens were changed are parsed again. Every other
+   * expression keeps its existing tree, so callers holding on to one of them can tell that it was
+   * not affected by comparing pointers.
+   *
+   * As with the tokens in `lexer::incremental_lexer`, the expressions are kept in a
+   * `lexer::gap_buffer` with the gap at the last edit, and the expressions after the gap have
+   * their token indices shifted on access, so an edit only updates the expressions it replaces.
+   */
+  class incremental_parser
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /**
+     * Constructs a new `lexer::incremental_parser` instance, parsing the whole of the input.
+     *
+     * @exception lexer::invalid_token_error
+     * Thrown if the input contains an invalid token.
+     *
+     * @exception lexer::parse_error
+     * Thrown if the input contains an invalid expression.
+     */
+    incremental_parser(std::string input);
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the current contents of the buffer. */
+    const std::string& input() const
+    {
+      return m_lexer.input();
+    }
+
+    /**
+     * Returns a copy of all of the tokens for the current contents of the buffer, ending with an
+     * `eof` token. This takes time in proportion to the number of tokens.
+     */
+    std::vector<lexer::token> tokens() const
+    {
+      return m_lexer.tokens();
+    }
+
+    /** Returns the number of top-level expressions for the current contents of the buffer. */
+    std::size_t expression_count() const
+    {
+      return m_expressions.size();
+    }
+
+    /** Returns the top-level expression at the specified index. */
+    lexer::parsed_expression expression_at(std::size_t index) const;
+
+    /**
+     * Returns a copy of all of the top-level expressions for the current contents of the buffer.
+     * This takes time in proportion to the number of expressions.
+     */
+    std::vector<lexer::parsed_expression> expressions() const;
+
+    /**
+     * Applies an edit to the buffer, re-parsing only the expressions it touches, and returns the
+     * range of expressions which changed.
+     *
+     * @exception std::out_of_range
+     * Thrown if the edit extends beyond the end of the buffer.
+     *
+     * @exception lexer::invalid_token_error
+     * Thrown if the edited buffer contains an invalid token.
+     *
+     * @exception lexer::parse_error
+     * Thrown if the edited buffer contains an invalid expression.
+     *
+     * If an exception is thrown, the buffer, tokens and expressions are left unchanged.
+     */
+    lexer::expression_change apply(const lexer::text_edit& edit);
+
+    /* -- Implementation -- */
+
+  private:
+
+    /** Returns the index of the first token of the expression at the specified index. */
+    std::size_t first_token_at(std::size_t index) const;
+
+    lexer::incremental_lexer m_lexer;
+    lexer::gap_buffer<lexer::parsed_expression> m_expressions;
+
+    /** The amount to add to the stored token indices of the expressions after the gap. */
+    std::size_t m_token_delta;
+
+  };
+
+}
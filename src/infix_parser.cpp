@@ -0,0 +1,205 @@
+/**
+ * @file	infix_parser.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/26
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "expression.hpp"
+#include "infix_parser.hpp"
+#include "lexical_analyzer.hpp"
+#include "syntax_analyzer.hpp"
+#include "token.hpp"
+#include "token_stream.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Types -- */
+
+namespace
+{
+
+  /** Struct representing an operator or open bracket on the stack. */
+  struct pending
+  {
+
+    /** `true` if this is an open bracket rather than an operator. */
+    bool is_bracket;
+
+    /** The operator, if this is not an open bracket. */
+    operator_type op;
+
+    /** The precedence of the operator, if this is not an open bracket. */
+    int precedence;
+
+  };
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Gets an operator type and its precedence from the specified token. */
+  bool get_operator(const token& tok, operator_type& op, int& precedence)
+  {
+    if (tok.type() != token_type::op)
+      return false;
+
+    const auto& lexeme = tok.lexeme();
+    if (lexeme == "+" || lexeme == "-")
+    {
+      op = (lexeme == "+" ? operator_type::addition : operator_type::subtraction);
+      precedence = 1;
+    }
+    else if (lexeme == "*" || lexeme == "/")
+    {
+      op = (lexeme == "*" ? operator_type::multiplication : operator_type::division);
+      precedence = 2;
+    }
+    else
+      return false;
+
+    return true;
+  }
+
+}
+
+/* -- Types -- */
+
+struct infix_parser::implementation
+{
+
+  /* -- Constructor -- */
+
+  implementation(lexical_analyzer& lex)
+    : tokens(lex)
+  { }
+
+  /* -- Fields -- */
+
+  token_stream tokens;
+
+  /** Stack of operands which have been parsed. */
+  vector<unique_ptr<const expression>> operands;
+
+  /** Stack of operators and open brackets which are still waiting for operands. */
+  vector<pending> operators;
+
+  /** The open bracket tokens on the operator stack, in case they are never closed. */
+  vector<token> brackets;
+
+  /* -- Methods -- */
+
+  /** Combines the top two operands with the operator on top of the stack. */
+  void reduce()
+  {
+    auto right = move(operands.back());
+    operands.pop_back();
+    auto left = move(operands.back());
+    operands.pop_back();
+    operands.push_back(make_unique<compound_expression>(operators.back().op,
+                                                        move(left),
+                                                        move(right)));
+    operators.pop_back();
+  }
+
+  /** Reduces operators until the top of the stack is an open bracket or of lower precedence. */
+  void reduce(int precedence)
+  {
+    while (!operators.empty() &&
+           !operators.back().is_bracket &&
+           operators.back().precedence >= precedence)
+    {
+      reduce();
+    }
+  }
+
+  /** Parses the next expression. */
+  unique_ptr<const expression> parse()
+  {
+    operands.clear();
+    operators.clear();
+    brackets.clear();
+
+    if (tokens.peek().type() == token_type::eof)
+      return nullptr;
+
+    bool expect_operand = true;
+    while (true)
+    {
+      const auto& tok = tokens.peek();
+      if (expect_operand)
+      {
+        int value = 0;
+        if (token_value(tok, value))
+        {
+          operands.push_back(make_unique<simple_expression>(value));
+          expect_operand = false;
+        }
+        else if (tok.type() == token_type::open_bracket)
+        {
+          operators.push_back({ true, operator_type(), 0 });
+          brackets.push_back(tok);
+        }
+        else
+          throw parse_error(tok);
+        tokens.advance();
+        continue;
+      }
+
+      operator_type op;
+      int precedence = 0;
+      if (get_operator(tok, op, precedence))
+      {
+        // everything of the same precedence is left associative, so reduce those too
+        reduce(precedence);
+        operators.push_back({ false, op, precedence });
+        expect_operand = true;
+      }
+      else if (tok.type() == token_type::close_bracket)
+      {
+        if (brackets.empty())
+          throw parse_error(tok);
+        reduce(0);
+        operators.pop_back();
+        brackets.pop_back();
+      }
+      else
+      {
+        // anything else starts the next expression
+        if (!brackets.empty())
+          throw parse_error(brackets.back());
+        reduce(0);
+        break;
+      }
+      tokens.advance();
+    }
+
+    return move(operands.back());
+  }
+
+};
+
+/* -- Procedures -- */
+
+infix_parser::infix_parser(lexical_analyzer& lex)
+  : impl(make_unique<implementation>(lex))
+{
+}
+
+infix_parser::~infix_parser() = default;
+
+unique_ptr<const expression> infix_parser::next_expression()
+{
+  return impl->parse();
+}
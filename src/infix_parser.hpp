@@ -0,0 +1,69 @@
+/**
+ * @file	infix_parser.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/26
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <memory>
+
+#include "expression.hpp"
+#include "lexical_analyzer.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class responsible for parsing conventional infix expressions, e.g. `1 + 2 * 3 - 4 / 5`.
+   *
+   * Multiplication and division bind more tightly than addition and subtraction, and operators of
+   * the same precedence are left associative. Brackets may be used for grouping, so fully
+   * parenthesized expressions are parsed to the same trees as by `lexer::syntax_analyzer`.
+   *
+   * Pending operators and open brackets are kept on an explicit stack rather than by recursion,
+   * so long operator chains and deeply nested brackets cannot overflow the call stack.
+   */
+  class infix_parser
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::infix_parser` reading tokens from the specified lexer. */
+    infix_parser(lexer::lexical_analyzer& lex);
+
+    /** Destructor. */
+    ~infix_parser();
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /**
+     * Parses the next top-level expression, or returns `nullptr` at the end of the input.
+     *
+     * An expression ends at the first token after a complete operand which is neither an
+     * operator nor a close bracket, so `1 + 2 3 * 4` is two expressions.
+     *
+     * @exception lexer::parse_error
+     * Thrown if the tokens do not form a valid expression. A bracket which is never closed is
+     * blamed on its open bracket.
+     */
+    std::unique_ptr<const lexer::expression> next_expression();
+
+    /* -- Implementation -- */
+
+  private:
+
+    struct implementation;
+    std::unique_ptr<implementation> impl;
+
+  };
+
+}
@@ -11,8 +11,11 @@
 #include <regex>
 #include <sstream>
 #include <string>
+#include <vector>
 
+#include "diagnostic.hpp"
 #include "lexical_analyzer.hpp"
+#include "result.hpp"
 
 /* -- Namespaces -- */
 
@@ -25,71 +28,111 @@ namespace
 {
   const regex eof_regex { "^$" };
   const regex number_regex { "^[0-9]+" };
-  const regex op_regex { "^[\\+|-|\\*|/]" };
+  const regex op_regex { "^[-+*/]" };
   const regex open_bracket_regex { "^\\(" };
   const regex close_bracket_regex { "^\\)" };
 }
 
-/* -- Types -- */
+/* -- Private Procedures -- */
 
-struct lexical_analyzer::implementation
+namespace
 {
 
-  /* -- Fields -- */
-
-  string input;
-  string::const_iterator it;
-  int line_number { 0 };
-  int column_number { 0 };
-
-  /* -- Methods -- */
-
-  /** Returns `true` if the iterator is at the end of the input string. */
-  bool at_eof() const
+  /** Advances a location past the specified number of characters. */
+  void advance(const string& input, source_location& location, size_t count = 1)
   {
-    return (it == input.cend());
-  }
-
-  /** Advances the read iterator. */
-  void advance(string::const_iterator::difference_type diff = 1)
-  {
-    for (string::const_iterator::difference_type idx = 0; idx < diff; idx++)
+    for (size_t idx = 0; idx < count; idx++)
     {
-      if (*it == '\n')
+      if (input[location.offset] == '\n')
       {
-        ++line_number;
-        column_number = 0;
+        ++location.line_number;
+        location.column_number = 0;
       }
       else
-        ++column_number;
-      ++it;
+        ++location.column_number;
+      ++location.offset;
     }
   }
 
-  /** Skips any whitespace. */
-  void skip_whitespace()
-  {
-    while (it != input.cend() && isspace(*it))
-      advance();
-  }
-
-  /** Attempts to extract a lexeme using the specified regex. */
-  bool read_token(token_type type, const regex& rex, token& token)
+  /** Attempts to extract a lexeme at the specified location using the specified regex. */
+  bool read_lexeme(const string& input,
+                   source_location& location,
+                   token_type type,
+                   const regex& rex,
+                   token& token)
   {
+    // the match must start at the location, so there is no point searching any further
     smatch match;
-    if (!regex_search(it, input.cend(), match, rex))
+    if (!regex_search(input.cbegin() + location.offset, input.cend(), match, rex,
+                      regex_constants::match_continuous))
       return false;
 
     const std::string& lexeme = match[0];
     token.set_type(type);
     token.set_lexeme(lexeme);
-    token.set_line_number(line_number);
-    token.set_column_number(column_number);
+    token.set_line_number(location.line_number);
+    token.set_column_number(location.column_number);
+    token.set_offset(location.offset);
 
-    advance(lexeme.size());
+    advance(input, location, lexeme.size());
     return true;
   }
 
+  /**
+   * Attempts to read the token at the specified location, skipping any whitespace before it.
+   * If there is no valid token, the location is left at the start of the invalid one.
+   */
+  bool try_read_token(const string& input, source_location& location, token& tok)
+  {
+    while (location.offset < input.size() && isspace(input[location.offset]))
+      advance(input, location);
+
+    return (read_lexeme(input, location, token_type::eof, eof_regex, tok) ||
+            read_lexeme(input, location, token_type::number, number_regex, tok) ||
+            read_lexeme(input, location, token_type::op, op_regex, tok) ||
+            read_lexeme(input, location, token_type::open_bracket, open_bracket_regex, tok) ||
+            read_lexeme(input, location, token_type::close_bracket, close_bracket_regex, tok));
+  }
+
+  /**
+   * Skips the invalid token at the specified location, up to the next whitespace or the next
+   * position where a valid token starts, and returns a diagnostic for it.
+   */
+  diagnostic skip_invalid_token(const string& input, source_location& location)
+  {
+    auto start = location;
+    token tok;
+    while (true)
+    {
+      advance(input, location);
+      if (location.offset < input.size() && isspace(input[location.offset]))
+        break;
+      auto next = location;
+      if (try_read_token(input, next, tok))
+        break;
+    }
+
+    return { diagnostic_kind::invalid_token,
+             start.offset,
+             location.offset - start.offset,
+             start.line_number,
+             start.column_number };
+  }
+
+}
+
+/* -- Types -- */
+
+struct lexical_analyzer::implementation
+{
+
+  /* -- Fields -- */
+
+  string input;
+  source_location location;
+  size_t origin { 0 };
+  vector<diagnostic>* diagnostics { nullptr };
+
 };
 
 /* -- Procedures -- */
@@ -106,22 +149,70 @@ lexical_analyzer::lexical_analyzer(string input)
   : impl(make_unique<implementation>())
 {
   impl->input = move(input);
-  impl->it = impl->input.cbegin();
+}
+
+lexical_analyzer::lexical_analyzer(string input, source_location origin)
+  : impl(make_unique<implementation>())
+{
+  impl->input = move(input);
+  impl->location.line_number = origin.line_number;
+  impl->location.column_number = origin.column_number;
+  impl->origin = origin.offset;
+}
+
+lexical_analyzer::lexical_analyzer(string input, vector<diagnostic>& diagnostics)
+  : impl(make_unique<implementation>())
+{
+  impl->input = move(input);
+  impl->diagnostics = &diagnostics;
 }
 
 lexical_analyzer::~lexical_analyzer() = default;
 
 token lexical_analyzer::next_token()
 {
-  impl->skip_whitespace();
+  if (!impl->diagnostics)
+  {
+    auto tok = read_token(impl->input, impl->location);
+    tok.set_offset(tok.offset() + impl->origin);
+    return tok;
+  }
+
+  // record and skip invalid tokens until we find a valid one - the end of the input is always
+  // valid, so this stops eventually
+  token tok;
+  while (!try_read_token(impl->input, impl->location, tok))
+  {
+    auto diag = skip_invalid_token(impl->input, impl->location);
+    diag.offset += impl->origin;
+    impl->diagnostics->push_back(diag);
+  }
+  tok.set_offset(tok.offset() + impl->origin);
+  return tok;
+}
+
+result<token> lexical_analyzer::try_next_token()
+{
+  if (impl->diagnostics)
+    return next_token();
 
   token tok;
-  if (impl->read_token(token_type::eof, eof_regex, tok) ||
-      impl->read_token(token_type::number, number_regex, tok) ||
-      impl->read_token(token_type::op, op_regex, tok) ||
-      impl->read_token(token_type::open_bracket, open_bracket_regex, tok) ||
-      impl->read_token(token_type::close_bracket, close_bracket_regex, tok))
-    return tok;
+  if (!try_read_token(impl->input, impl->location, tok))
+  {
+    // measure the invalid token on a copy of the location, so that we stay where we are
+    auto location = impl->location;
+    auto diag = skip_invalid_token(impl->input, location);
+    diag.offset += impl->origin;
+    return diag;
+  }
+  tok.set_offset(tok.offset() + impl->origin);
+  return tok;
+}
 
-  throw invalid_token_error(impl->line_number, impl->column_number);
+token lexer::read_token(const string& input, source_location& location)
+{
+  token tok;
+  if (!try_read_token(input, location, tok))
+    throw invalid_token_error(location.line_number, location.column_number);
+  return tok;
 }
@@ -8,10 +8,14 @@
 
 /* -- Includes -- */
 
+#include <cstddef>
 #include <exception>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "diagnostic.hpp"
+#include "result.hpp"
 #include "token.hpp"
 
 /* -- Types -- */
@@ -46,6 +50,23 @@ namespace lexer
 
   };
 
+  /**
+   * Struct representing a position in the input.
+   */
+  struct source_location
+  {
+
+    /** The offset from the start of the input. */
+    std::size_t offset { 0 };
+
+    /** The line number. */
+    int line_number { 0 };
+
+    /** The column number. */
+    int column_number { 0 };
+
+  };
+
   /**
    * Class responsible for lexical analysis.
    */
@@ -59,6 +80,21 @@ namespace lexer
     /** Constructs a new `lexer::lexical_analyzer` instance for the specified input string. */
     lexical_analyzer(std::string input);
 
+    /**
+     * Constructs a new `lexer::lexical_analyzer` instance for a piece of a larger input, which
+     * starts at the specified location of the larger input. Tokens are reported at their locations
+     * in the larger input.
+     */
+    lexical_analyzer(std::string input, lexer::source_location origin);
+
+    /**
+     * Constructs a new `lexer::lexical_analyzer` instance which recovers from invalid tokens.
+     *
+     * Rather than throwing `lexer::invalid_token_error`, the lexer appends a diagnostic to
+     * `diagnostics` and skips to the next whitespace or valid token.
+     */
+    lexical_analyzer(std::string input, std::vector<lexer::diagnostic>& diagnostics);
+
     /** Destructor. */
     ~lexical_analyzer();
 
@@ -69,6 +105,13 @@ namespace lexer
     /** Returns the next token from the input. */
     lexer::token next_token();
 
+    /**
+     * Returns the next token from the input, or a diagnostic rather than throwing
+     * `lexer::invalid_token_error` if there is no valid token. The lexer is left at the invalid
+     * token, so it is returned again by the next call.
+     */
+    lexer::result<lexer::token> try_next_token();
+
     /* -- Implementation -- */
 
   private:
@@ -79,3 +122,22 @@ namespace lexer
   };
 
 }
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Reads the token at the specified location of the input, skipping any whitespace before it,
+   * and advances the location past it.
+   *
+   * Each token depends only on the characters from its start up to (and including) the character
+   * after it, so lexing can be restarted from the location of any token.
+   *
+   * @exception lexer::invalid_token_error
+   * Thrown if there is no valid token at the location.
+   */
+  lexer::token read_token(const std::string& input, lexer::source_location& location);
+
+}
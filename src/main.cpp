@@ -8,9 +8,13 @@
 
 #include <exception>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "expression.hpp"
 #include "lexical_analyzer.hpp"
+#include "regex_dfa.hpp"
+#include "regex_dfa_file.hpp"
 #include "regex_nfa.hpp"
 #include "regex_postfix.hpp"
 #include "syntax_analyzer.hpp"
@@ -50,12 +54,49 @@ namespace
       cerr << ex.what() << endl;
     }
   }
+
+  /**
+   * Handles the `compile` subcommand.
+   *
+   * Usage: `lexer compile <output file> <regex>...`
+   *
+   * Compiles the regular expressions to a single DFA, tagging each state with the index of the
+   * (first) pattern it accepts, and writes it to the output file for `lexer::load_regex_dfa`.
+   */
+  int compile_command(int argc, char** argv)
+  {
+    if (argc < 4)
+    {
+      cerr << "Usage: " << argv[0] << " compile <output file> <regex>..." << endl;
+      return 1;
+    }
+
+    try
+    {
+      vector<string> regexes(argv + 3, argv + argc);
+      regex_dfa dfa = regexes_to_dfa(regexes);
+      save_regex_dfa(dfa, argv[2]);
+      cout << "Compiled " << regexes.size() << " pattern(s) to " << dfa.state_count()
+           << " states." << endl;
+    }
+    catch (const exception& ex)
+    {
+      cerr << ex.what() << endl;
+      return 1;
+    }
+
+    return 0;
+  }
+
 }
 
 /* -- Procedures -- */
 
 int main(int argc, char** argv)
 {
+  if (argc > 1 && string(argv[1]) == "compile")
+    return compile_command(argc, argv);
+
   static const string REGEX = "a?bc";
 
   cout << boolalpha;
@@ -0,0 +1,171 @@
+/**
+ * @file	parallel_parser.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/21
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expression.hpp"
+#include "lexical_analyzer.hpp"
+#include "parallel_parser.hpp"
+#include "syntax_analyzer.hpp"
+#include "work_stealing_pool.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Constants -- */
+
+namespace
+{
+
+  /** Minimum size of a chunk for `lexer::parse_parallel`, so that tiny inputs are not split. */
+  const size_t min_chunk_size = 4 * 1024;
+
+  /** Number of chunks for each worker, so that uneven chunks can be balanced by stealing. */
+  const size_t chunks_per_thread = 4;
+
+  /** A word with every byte set to one. */
+  const uint64_t ones = 0x0101010101010101ull;
+
+  /** A word with the high bit of every byte set. */
+  const uint64_t highs = 0x8080808080808080ull;
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns `true` if any byte of a word is equal to the specified byte. */
+  bool has_byte(uint64_t word, unsigned char byte)
+  {
+    auto diff = word ^ (ones * byte);
+    return ((diff - ones) & ~diff & highs) != 0;
+  }
+
+  /** Returns `true` if any byte of a word affects bracket depth or line numbers. */
+  bool has_structure(uint64_t word)
+  {
+    return (has_byte(word, '(') || has_byte(word, ')') || has_byte(word, '\n'));
+  }
+
+  /** Returns `true` if both of the specified characters are digits. */
+  bool both_digits(char ch1, char ch2)
+  {
+    return (isdigit(static_cast<unsigned char>(ch1)) && isdigit(static_cast<unsigned char>(ch2)));
+  }
+
+}
+
+/* -- Procedures -- */
+
+vector<source_location> lexer::split_top_level(const string& input, size_t min_size)
+{
+  vector<source_location> chunks(1);
+  min_size = max<size_t>(min_size, 1);
+
+  const char* data = input.data();
+  size_t size = input.size();
+  size_t target = min_size;
+  size_t depth = 0;
+  size_t line_start = 0;
+  int line_number = 0;
+
+  for (size_t pos = 0; pos < size; )
+  {
+    // whole words with no brackets or line breaks cannot change anything, unless we are looking
+    // for a place to split
+    if ((depth != 0 || pos + sizeof(uint64_t) <= target) && pos + sizeof(uint64_t) <= size)
+    {
+      uint64_t word;
+      memcpy(&word, data + pos, sizeof(word));
+      if (!has_structure(word))
+      {
+        pos += sizeof(word);
+        continue;
+      }
+    }
+
+    if (depth == 0 && pos >= target && !both_digits(data[pos - 1], data[pos]))
+    {
+      source_location location;
+      location.offset = pos;
+      location.line_number = line_number;
+      location.column_number = static_cast<int>(pos - line_start);
+      chunks.push_back(location);
+      target = pos + min_size;
+    }
+
+    switch (data[pos])
+    {
+    case '(':
+      depth++;
+      break;
+    case ')':
+      // stray close brackets are a parse error, which is reported wherever the chunk starts
+      if (depth != 0)
+        depth--;
+      break;
+    case '\n':
+      line_number++;
+      line_start = pos + 1;
+      break;
+    default:
+      break;
+    }
+    pos++;
+  }
+
+  return chunks;
+}
+
+vector<unique_ptr<const expression>> lexer::parse_parallel(const string& input,
+                                                           work_stealing_pool& pool)
+{
+  auto min_size = max(min_chunk_size, input.size() / (pool.thread_count() * chunks_per_thread));
+  auto chunks = split_top_level(input, min_size);
+
+  // every chunk starts where a top-level expression would, so parsing it on its own finds the same
+  // expressions, or the same first error, as parsing from the start of the input
+  vector<vector<unique_ptr<const expression>>> results(chunks.size());
+  vector<exception_ptr> errors(chunks.size());
+  pool.run(chunks.size(), [&] (size_t idx) {
+      try
+      {
+        auto begin = chunks[idx].offset;
+        auto end = (idx + 1 < chunks.size() ? chunks[idx + 1].offset : input.size());
+        lexical_analyzer lex(input.substr(begin, end - begin), chunks[idx]);
+        syntax_analyzer syn(lex);
+        while (auto expr = syn.next_expression())
+          results[idx].push_back(move(expr));
+      }
+      catch (...)
+      {
+        errors[idx] = current_exception();
+      }
+    });
+
+  vector<unique_ptr<const expression>> expressions;
+  for (size_t idx = 0; idx < chunks.size(); idx++)
+  {
+    if (errors[idx])
+      rethrow_exception(errors[idx]);
+    for (auto& expr : results[idx])
+      expressions.push_back(move(expr));
+  }
+  return expressions;
+}
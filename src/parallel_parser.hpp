@@ -0,0 +1,51 @@
+/**
+ * @file	parallel_parser.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/21
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expression.hpp"
+#include "lexical_analyzer.hpp"
+#include "work_stealing_pool.hpp"
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Splits an input into chunks of whole top-level expressions, returning the location at which
+   * each chunk starts. The first chunk always starts at the beginning of the input.
+   *
+   * Chunks are at least `min_size` characters long (apart from the last one). They are split only
+   * where the bracket depth is zero, and never within a number. The scan skips a word at a time
+   * over text with no brackets or line breaks, which is most of it.
+   */
+  std::vector<lexer::source_location> split_top_level(const std::string& input,
+                                                      std::size_t min_size);
+
+  /**
+   * Parses all of the top-level expressions in an input, returning them in input order.
+   *
+   * The input is split with `lexer::split_top_level`, and the chunks are lexed and parsed in
+   * parallel on the specified pool.
+   *
+   * @exception lexer::invalid_token_error
+   * @exception lexer::parse_error
+   * Thrown if the input is invalid. This is the same error, with the same line and column, as
+   * parsing the input from start to end would throw.
+   */
+  std::vector<std::unique_ptr<const lexer::expression>> parse_parallel(
+    const std::string& input,
+    lexer::work_stealing_pool& pool = lexer::work_stealing_pool::global());
+
+}
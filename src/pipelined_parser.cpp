@@ -0,0 +1,227 @@
+/**
+ * @file	pipelined_parser.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/22
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "expression.hpp"
+#include "lexical_analyzer.hpp"
+#include "pipelined_parser.hpp"
+#include "spsc_queue.hpp"
+#include "syntax_analyzer.hpp"
+#include "token.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Types -- */
+
+namespace
+{
+
+  /** Struct representing a batch of tokens passed from the lexer to the parser. */
+  struct token_batch
+  {
+
+    /** The tokens, the last of which is `eof` if this is the last batch. */
+    vector<token> tokens;
+
+    /** The error which stopped the lexer after these tokens, if there was one. */
+    exception_ptr error;
+
+  };
+
+  /** Struct representing a batch of expressions passed from the parser to the consumer. */
+  struct expression_batch
+  {
+
+    /** The expressions. */
+    vector<unique_ptr<const expression>> expressions;
+
+    /** The error which stopped the parser after these expressions, if there was one. */
+    exception_ptr error;
+
+    /** `true` if this is the last batch. */
+    bool last { false };
+
+  };
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Pushes an item onto a queue, waiting while it is full. Returns `false` if cancelled. */
+  template <typename T>
+  bool push(spsc_queue<T>& queue, T& item, const atomic<bool>& cancelled)
+  {
+    while (!queue.try_push(item))
+    {
+      if (cancelled.load(memory_order_relaxed))
+        return false;
+      this_thread::yield();
+    }
+    return true;
+  }
+
+  /** Pops an item off of a queue, waiting while it is empty. Returns `false` if cancelled. */
+  template <typename T>
+  bool pop(spsc_queue<T>& queue, T& item, const atomic<bool>& cancelled)
+  {
+    while (!queue.try_pop(item))
+    {
+      if (cancelled.load(memory_order_relaxed))
+        return false;
+      this_thread::yield();
+    }
+    return true;
+  }
+
+  /** Runs the lexer stage, passing batches of tokens to the parser. */
+  void lex_stage(string input,
+                 spsc_queue<token_batch>& output,
+                 size_t batch_size,
+                 const atomic<bool>& cancelled)
+  {
+    lexical_analyzer lex(move(input));
+    token_batch batch;
+    try
+    {
+      while (true)
+      {
+        batch.tokens.push_back(lex.next_token());
+        if (batch.tokens.back().type() == token_type::eof)
+          break;
+        if (batch.tokens.size() == batch_size)
+        {
+          if (!push(output, batch, cancelled))
+            return;
+          batch = token_batch();
+          batch.tokens.reserve(batch_size);
+        }
+      }
+    }
+    catch (...)
+    {
+      batch.error = current_exception();
+    }
+    push(output, batch, cancelled);
+  }
+
+  /** Runs the parser stage, passing batches of expressions to the consumer. */
+  void parse_stage(spsc_queue<token_batch>& input,
+                   spsc_queue<expression_batch>& output,
+                   size_t batch_size,
+                   const atomic<bool>& cancelled)
+  {
+    token_batch current;
+    size_t position = 0;
+
+    // the parser may ask for more tokens after `eof`, so keep returning the last one - if the lexer
+    // failed, its error is only thrown if the parser gets that far, so that earlier parse errors
+    // are reported first
+    auto next_token = [&] () -> token {
+      while (position == current.tokens.size())
+      {
+        if (position != 0 && current.tokens.back().type() == token_type::eof)
+          return current.tokens.back();
+        if (current.error)
+          rethrow_exception(current.error);
+        if (!pop(input, current, cancelled))
+          throw runtime_error("Pipeline was cancelled!");
+        position = 0;
+      }
+      return current.tokens[position++];
+    };
+
+    expression_batch batch;
+    try
+    {
+      while (auto expr = parse_expression(next_token))
+      {
+        batch.expressions.push_back(move(expr));
+        if (batch.expressions.size() == batch_size)
+        {
+          if (!push(output, batch, cancelled))
+            return;
+          batch = expression_batch();
+        }
+      }
+    }
+    catch (...)
+    {
+      batch.error = current_exception();
+    }
+    batch.last = true;
+    push(output, batch, cancelled);
+  }
+
+}
+
+/* -- Procedures -- */
+
+void lexer::parse_pipelined(string input,
+                            const function<void(unique_ptr<const expression>)>& consumer,
+                            const pipeline_options& options)
+{
+  auto token_batch_size = max<size_t>(options.token_batch_size, 1);
+  auto expression_batch_size = max<size_t>(options.expression_batch_size, 1);
+  auto queue_capacity = max<size_t>(options.queue_capacity, 1);
+
+  spsc_queue<token_batch> tokens(queue_capacity);
+  spsc_queue<expression_batch> expressions(queue_capacity);
+  atomic<bool> cancelled(false);
+
+  thread lexer_thread(lex_stage,
+                      move(input),
+                      ref(tokens),
+                      token_batch_size,
+                      cref(cancelled));
+  thread parser_thread(parse_stage,
+                       ref(tokens),
+                       ref(expressions),
+                       expression_batch_size,
+                       cref(cancelled));
+
+  // if the consumer fails, the other stages give up as soon as they next wait on a queue
+  exception_ptr error;
+  try
+  {
+    expression_batch batch;
+    do
+    {
+      pop(expressions, batch, cancelled);
+      for (auto& expr : batch.expressions)
+        consumer(move(expr));
+      if (batch.error)
+        rethrow_exception(batch.error);
+    }
+    while (!batch.last);
+  }
+  catch (...)
+  {
+    error = current_exception();
+    cancelled = true;
+  }
+
+  lexer_thread.join();
+  parser_thread.join();
+  if (error)
+    rethrow_exception(error);
+}
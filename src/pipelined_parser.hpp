@@ -0,0 +1,65 @@
+/**
+ * @file	pipelined_parser.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/22
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "expression.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Struct containing options for `lexer::parse_pipelined`.
+   */
+  struct pipeline_options
+  {
+
+    /** The number of tokens passed from the lexer to the parser at a time. */
+    std::size_t token_batch_size { 256 };
+
+    /** The number of expressions passed from the parser to the consumer at a time. */
+    std::size_t expression_batch_size { 32 };
+
+    /** The number of batches which may be waiting between two stages. */
+    std::size_t queue_capacity { 16 };
+
+  };
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Parses all of the top-level expressions in an input, passing each one to `consumer` in input
+   * order, with lexing, parsing and the consumer overlapped on three threads.
+   *
+   * The lexer and the parser run on their own threads, and the consumer is called on the calling
+   * thread. The stages are connected by bounded `lexer::spsc_queue`s, so a stage which gets ahead
+   * waits for the one after it rather than buffering the whole input.
+   *
+   * @exception lexer::invalid_token_error
+   * @exception lexer::parse_error
+   * Thrown if the input is invalid. The consumer has been called for every expression before the
+   * error, just as it would be by a serial loop over `lexer::syntax_analyzer::next_expression`.
+   * Any exception thrown by the consumer stops the pipeline and is passed on to the caller.
+   */
+  void parse_pipelined(std::string input,
+                       const std::function<void(std::unique_ptr<const lexer::expression>)>& consumer,
+                       const lexer::pipeline_options& options = lexer::pipeline_options());
+
+}
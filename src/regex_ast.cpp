@@ -0,0 +1,493 @@
+/**
+ * @file	regex_ast.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/17
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "regex_ast.hpp"
+#include "regex_charset.hpp"
+#include "regex_constants.hpp"
+#include "regex_postfix.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  using node_ptr = unique_ptr<regex_ast>;
+  using node_list = vector<node_ptr>;
+
+  /** Returns `true` for the types of nodes which may be nested within each other to no effect. */
+  bool is_unary_repetition(regex_ast_type type)
+  {
+    return (type == regex_ast_type::optional ||
+            type == regex_ast_type::kleene ||
+            type == regex_ast_type::repeat);
+  }
+
+  /**
+   * Returns a concatenation or alternation of the specified nodes, splicing in the children of
+   * any nodes which are of the same type, or the only node if there is just one.
+   */
+  node_ptr make_list(regex_ast_type type, node_list nodes)
+  {
+    node_list children;
+    for (auto& node : nodes)
+    {
+      if (node->type() == type)
+      {
+        for (auto& child : node->children())
+          children.push_back(move(child));
+      }
+      else
+        children.push_back(move(node));
+    }
+
+    if (children.size() == 1)
+      return move(children.front());
+    return regex_ast::create_operator(type, move(children));
+  }
+
+  /** Returns a node applying `?`, `*` or `+` to the specified node, collapsing nested operators. */
+  node_ptr make_unary(regex_ast_type type, node_ptr child)
+  {
+    if (is_unary_repetition(child->type()))
+    {
+      // the same operator twice has no effect, and any other combination is a kleene star
+      if (child->type() == type)
+        return child;
+      type = regex_ast_type::kleene;
+      child = move(child->children().front());
+    }
+
+    node_list children;
+    children.push_back(move(child));
+    return regex_ast::create_operator(type, move(children));
+  }
+
+  /** Appends the postfix notation which follows the specified child of a node to a string. */
+  void append_postfix_operator(string& postfix, const regex_ast& node, size_t child)
+  {
+    switch (node.type())
+    {
+
+    case regex_ast_type::atom:
+      break;
+
+    case regex_ast_type::concatenation:
+      if (child > 0)
+        postfix.push_back(regex_constants::concat_op);
+      break;
+
+    case regex_ast_type::alternation:
+      if (child > 0)
+        postfix.push_back(regex_constants::union_op);
+      break;
+
+    case regex_ast_type::optional:
+      postfix.push_back(regex_constants::optional_op);
+      break;
+
+    case regex_ast_type::kleene:
+      postfix.push_back(regex_constants::kleene_op);
+      break;
+
+    case regex_ast_type::repeat:
+      postfix.push_back(regex_constants::repeat_op);
+      break;
+
+    case regex_ast_type::repetition:
+    {
+      const auto& repetition = node.repetition();
+      postfix.push_back(regex_constants::open_repetition_op);
+      postfix += to_string(repetition.min);
+      if (repetition.max != repetition.min)
+      {
+        postfix.push_back(regex_constants::repetition_separator);
+        if (repetition.max != regex_repetition::unbounded)
+          postfix += to_string(repetition.max);
+      }
+      postfix.push_back(regex_constants::close_repetition_op);
+      break;
+    }
+
+    }
+  }
+
+  /** Appends the postfix notation for a node to a string. */
+  void append_postfix(string& postfix, const regex_ast& root)
+  {
+    // each frame is a node and the index of its next child to visit
+    vector<pair<const regex_ast*, size_t>> stack { { &root, 0 } };
+    while (!stack.empty())
+    {
+      const auto& node = *stack.back().first;
+      auto next = stack.back().second;
+      if (next > 0)
+        append_postfix_operator(postfix, node, next - 1);
+
+      if (next < node.children().size())
+      {
+        stack.back().second++;
+        stack.emplace_back(node.children()[next].get(), 0);
+        continue;
+      }
+
+      if (node.type() == regex_ast_type::atom)
+        postfix += regex_charset_atom(node.set());
+      stack.pop_back();
+    }
+  }
+
+  /** Returns `true` if two nodes are identical, not counting their children. */
+  bool node_equal(const regex_ast& ast1, const regex_ast& ast2)
+  {
+    if (ast1.type() != ast2.type() || ast1.children().size() != ast2.children().size())
+      return false;
+
+    switch (ast1.type())
+    {
+    case regex_ast_type::atom:
+      return (ast1.set() == ast2.set());
+    case regex_ast_type::repetition:
+      return (ast1.repetition().min == ast2.repetition().min &&
+              ast1.repetition().max == ast2.repetition().max);
+    default:
+      return true;
+    }
+  }
+
+  /** Simplifies a bounded repetition whose operand has already been simplified. */
+  node_ptr simplify_repetition(node_ptr node)
+  {
+    const auto repetition = node->repetition();
+    auto child = move(node->children().front());
+    auto unbounded = (repetition.max == regex_repetition::unbounded);
+
+    if (repetition.min == 1 && repetition.max == 1)
+      return child;
+    if (repetition.min == 0 && repetition.max == 1)
+      return make_unary(regex_ast_type::optional, move(child));
+    if (repetition.min == 0 && unbounded)
+      return make_unary(regex_ast_type::kleene, move(child));
+    if (repetition.min == 1 && unbounded)
+      return make_unary(regex_ast_type::repeat, move(child));
+
+    return regex_ast::create_repetition(move(child), repetition);
+  }
+
+  node_ptr simplify_alternation(node_list alternatives);
+
+  /**
+   * Factors common leading items out of alternatives, e.g. `abc|abd` becomes `ab(c|d)`.
+   *
+   * Alternatives are grouped by their first item, and each group of two or more is replaced by
+   * the longest prefix the group shares, followed by the alternation of the rest of each
+   * alternative. Factoring the whole prefix at once, rather than one item at a time, keeps the
+   * recursion through `simplify_alternation` bounded by the number of alternatives rather than
+   * the length of the prefix.
+   */
+  node_list factor_prefixes(node_list alternatives)
+  {
+    // local procedure to return the first item of an alternative
+    auto first_item = [] (const regex_ast& node) -> const regex_ast& {
+      return (node.type() == regex_ast_type::concatenation ? *node.children().front() : node);
+    };
+
+    // group alternatives by first item (keyed by its postfix notation), in order of appearance
+    unordered_map<string, size_t> keys;
+    vector<node_list> groups;
+    for (auto& alternative : alternatives)
+    {
+      string key;
+      append_postfix(key, first_item(*alternative));
+      auto it = keys.emplace(key, groups.size()).first;
+      if (it->second == groups.size())
+        groups.emplace_back();
+      groups[it->second].push_back(move(alternative));
+    }
+
+    node_list result;
+    for (auto& group : groups)
+    {
+      if (group.size() == 1)
+      {
+        result.push_back(move(group.front()));
+        continue;
+      }
+
+      // local procedure to return the item at an index of an alternative, if it has one
+      auto item = [] (const regex_ast& node, size_t idx) -> const regex_ast* {
+        if (node.type() != regex_ast_type::concatenation)
+          return (idx == 0 ? &node : nullptr);
+        return (idx < node.children().size() ? node.children()[idx].get() : nullptr);
+      };
+
+      // find the length of the prefix shared by the whole group
+      size_t length = 1;
+      for (bool shared = true; shared; )
+      {
+        const auto* first = item(*group.front(), length);
+        for (size_t idx = 1; first && idx < group.size(); idx++)
+        {
+          const auto* other = item(*group[idx], length);
+          if (!other || !regex_ast_equal(*first, *other))
+            first = nullptr;
+        }
+        if ((shared = (first != nullptr)))
+          length++;
+      }
+
+      // split each alternative into the prefix and the rest - alternatives which consist of only
+      // the prefix leave nothing behind, making the rest optional
+      node_list prefix;
+      node_list rests;
+      bool optional = false;
+      for (auto& alternative : group)
+      {
+        if (alternative->type() != regex_ast_type::concatenation)
+        {
+          prefix.clear();
+          prefix.push_back(move(alternative));
+          optional = true;
+          continue;
+        }
+
+        auto& children = alternative->children();
+        prefix.clear();
+        for (size_t idx = 0; idx < length; idx++)
+          prefix.push_back(move(children[idx]));
+        children.erase(children.begin(), children.begin() + length);
+        if (children.empty())
+          optional = true;
+        else
+          rests.push_back(children.size() == 1 ? move(children.front()) : move(alternative));
+      }
+
+      node_list items;
+      items.push_back(make_list(regex_ast_type::concatenation, move(prefix)));
+      if (!rests.empty())
+      {
+        auto rest = simplify_alternation(move(rests));
+        items.push_back(optional ? make_unary(regex_ast_type::optional, move(rest)) : move(rest));
+      }
+      result.push_back(make_list(regex_ast_type::concatenation, move(items)));
+    }
+
+    return result;
+  }
+
+  /** Simplifies an alternation whose alternatives have already been simplified. */
+  node_ptr simplify_alternation(node_list alternatives)
+  {
+    if (alternatives.size() > 1)
+    {
+      // flatten first, so that nested alternatives are factored along with the others
+      auto flattened = make_list(regex_ast_type::alternation, move(alternatives));
+      if (flattened->type() != regex_ast_type::alternation)
+        return flattened;
+      alternatives = factor_prefixes(move(flattened->children()));
+    }
+
+    // merge all single-character alternatives into the first one
+    node_list result;
+    size_t atom_index = 0;
+    regex_charset atom_set;
+    for (auto& alternative : alternatives)
+    {
+      if (alternative->type() == regex_ast_type::atom)
+      {
+        auto first = atom_set.none();
+        atom_set |= alternative->set();
+        if (!first)
+          continue;
+        atom_index = result.size();
+      }
+      result.push_back(move(alternative));
+    }
+    if (atom_set.any())
+      result[atom_index] = regex_ast::create_atom(atom_set);
+
+    return make_list(regex_ast_type::alternation, move(result));
+  }
+
+  /** Simplifies a node whose children have already been simplified. */
+  node_ptr simplify_node(node_ptr node)
+  {
+    switch (node->type())
+    {
+    case regex_ast_type::atom:
+      return node;
+    case regex_ast_type::concatenation:
+      return make_list(regex_ast_type::concatenation, move(node->children()));
+    case regex_ast_type::alternation:
+      return simplify_alternation(move(node->children()));
+    case regex_ast_type::optional:
+    case regex_ast_type::kleene:
+    case regex_ast_type::repeat:
+      return make_unary(node->type(), move(node->children().front()));
+    case regex_ast_type::repetition:
+      return simplify_repetition(move(node));
+    }
+
+    return node;
+  }
+
+  /** Simplifies a node and all of its children. */
+  node_ptr simplify(node_ptr root)
+  {
+    // each frame is the slot holding a node and the index of its next child to simplify - the
+    // slots stay put, since children are only replaced once they have been simplified
+    vector<pair<node_ptr*, size_t>> stack { { &root, 0 } };
+    while (!stack.empty())
+    {
+      auto& children = (*stack.back().first)->children();
+      auto next = stack.back().second;
+      if (next < children.size())
+      {
+        stack.back().second++;
+        stack.emplace_back(&children[next], 0);
+        continue;
+      }
+
+      auto* slot = stack.back().first;
+      *slot = simplify_node(move(*slot));
+      stack.pop_back();
+    }
+    return root;
+  }
+
+}
+
+/* -- Procedures -- */
+
+unique_ptr<regex_ast> lexer::postfix_to_ast(const string& postfix)
+{
+  node_list stack;
+
+  // local procedure to pop an operand off of the stack
+  auto pop_node = [&] () -> node_ptr {
+    if (stack.empty())
+      throw runtime_error("Regular expression is invalid!");
+    auto node = move(stack.back());
+    stack.pop_back();
+    return node;
+  };
+
+  // local procedure to replace the top of the stack with a unary operator applied to it
+  auto push_unary = [&] (regex_ast_type type) {
+    node_list children;
+    children.push_back(pop_node());
+    stack.push_back(regex_ast::create_operator(type, move(children)));
+  };
+
+  for (size_t idx = 0; idx < postfix.size(); idx++)
+  {
+    switch (postfix[idx])
+    {
+
+    case regex_constants::concat_op:
+    case regex_constants::union_op:
+    {
+      // operands of the same type are spliced in, so that long sequences do not produce deep trees
+      auto type = (postfix[idx] == regex_constants::concat_op ?
+                   regex_ast_type::concatenation :
+                   regex_ast_type::alternation);
+      node_list operands(2);
+      operands[1] = pop_node();
+      operands[0] = pop_node();
+      stack.push_back(make_list(type, move(operands)));
+      break;
+    }
+
+    case regex_constants::optional_op:
+      push_unary(regex_ast_type::optional);
+      break;
+
+    case regex_constants::kleene_op:
+      push_unary(regex_ast_type::kleene);
+      break;
+
+    case regex_constants::repeat_op:
+      push_unary(regex_ast_type::repeat);
+      break;
+
+    case regex_constants::open_repetition_op:
+    {
+      auto repetition = parse_regex_repetition(postfix, idx);
+      idx += repetition.length - 1;
+      stack.push_back(regex_ast::create_repetition(pop_node(), repetition));
+      break;
+    }
+
+    default:
+    {
+      size_t length = 0;
+      auto set = regex_atom_charset(postfix, idx, length);
+      idx += length - 1;
+      stack.push_back(regex_ast::create_atom(set));
+      break;
+    }
+
+    }
+  }
+
+  if (stack.size() != 1)
+    throw runtime_error("Regular expression is invalid!");
+
+  return move(stack.back());
+}
+
+unique_ptr<regex_ast> lexer::regex_to_ast(const string& regex)
+{
+  return postfix_to_ast(regex_to_postfix(regex));
+}
+
+string lexer::ast_to_postfix(const regex_ast& ast)
+{
+  string postfix;
+  append_postfix(postfix, ast);
+  return postfix;
+}
+
+bool lexer::regex_ast_equal(const regex_ast& ast1, const regex_ast& ast2)
+{
+  vector<pair<const regex_ast*, const regex_ast*>> pending { { &ast1, &ast2 } };
+  while (!pending.empty())
+  {
+    auto nodes = pending.back();
+    pending.pop_back();
+    if (!node_equal(*nodes.first, *nodes.second))
+      return false;
+
+    const auto& children1 = nodes.first->children();
+    const auto& children2 = nodes.second->children();
+    for (size_t idx = 0; idx < children1.size(); idx++)
+      pending.emplace_back(children1[idx].get(), children2[idx].get());
+  }
+  return true;
+}
+
+unique_ptr<regex_ast> lexer::simplify_regex_ast(unique_ptr<regex_ast> ast)
+{
+  return simplify(move(ast));
+}
+
+string lexer::regex_to_simplified_postfix(const string& regex)
+{
+  return ast_to_postfix(*simplify_regex_ast(regex_to_ast(regex)));
+}
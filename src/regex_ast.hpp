@@ -0,0 +1,215 @@
+/**
+ * @file	regex_ast.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/17
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "regex_charset.hpp"
+#include "regex_postfix.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Enumeration of the recognized regular expression syntax tree node types.
+   */
+  enum class regex_ast_type
+  {
+    atom,
+    concatenation,
+    alternation,
+    optional,
+    kleene,
+    repeat,
+    repetition,
+  };
+
+  /**
+   * Class representing a node in the syntax tree of a regular expression.
+   *
+   * Concatenations and alternations may have any number (at least two) of children, the other
+   * operators have exactly one, and atoms have none.
+   */
+  class regex_ast
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Creates a new atom node matching any byte in the specified set. */
+    static std::unique_ptr<lexer::regex_ast> create_atom(const lexer::regex_charset& set)
+    {
+      auto node = std::unique_ptr<lexer::regex_ast>(new lexer::regex_ast(lexer::regex_ast_type::atom));
+      node->m_set = set;
+      return node;
+    }
+
+    /** Creates a new operator node with the specified children. */
+    static std::unique_ptr<lexer::regex_ast> create_operator(
+      lexer::regex_ast_type type,
+      std::vector<std::unique_ptr<lexer::regex_ast>> children)
+    {
+      auto node = std::unique_ptr<lexer::regex_ast>(new lexer::regex_ast(type));
+      node->m_children = std::move(children);
+      return node;
+    }
+
+    /** Creates a new bounded repetition node. */
+    static std::unique_ptr<lexer::regex_ast> create_repetition(
+      std::unique_ptr<lexer::regex_ast> child,
+      const lexer::regex_repetition& repetition)
+    {
+      auto node = std::unique_ptr<lexer::regex_ast>(new lexer::regex_ast(lexer::regex_ast_type::repetition));
+      node->m_children.push_back(std::move(child));
+      node->m_repetition = repetition;
+      return node;
+    }
+
+  private:
+
+    /** Constructs a new `lexer::regex_ast` instance with the specified type. */
+    regex_ast(lexer::regex_ast_type type)
+      : m_type(type),
+        m_set(),
+        m_children(),
+        m_repetition()
+    { }
+
+  public:
+
+    /**
+     * Destructor.
+     *
+     * Descendants are released from a worklist rather than by each node destroying its own
+     * children, so that deeply nested trees cannot overflow the call stack.
+     */
+    ~regex_ast()
+    {
+      auto pending = std::move(m_children);
+      while (!pending.empty())
+      {
+        auto node = std::move(pending.back());
+        pending.pop_back();
+        if (!node)
+          continue;
+        for (auto& child : node->m_children)
+          pending.push_back(std::move(child));
+        node->m_children.clear();
+      }
+    }
+
+    regex_ast(const regex_ast&) = delete;
+    regex_ast& operator=(const regex_ast&) = delete;
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the type of this node. */
+    lexer::regex_ast_type type() const
+    {
+      return m_type;
+    }
+
+    /** Returns the set of bytes matched by this node, if it is an atom. */
+    const lexer::regex_charset& set() const
+    {
+      return m_set;
+    }
+
+    /** Returns the children of this node. */
+    const std::vector<std::unique_ptr<lexer::regex_ast>>& children() const
+    {
+      return m_children;
+    }
+
+    /** Returns the children of this node. */
+    std::vector<std::unique_ptr<lexer::regex_ast>>& children()
+    {
+      return m_children;
+    }
+
+    /** Returns the repetition counts for this node, if it is a bounded repetition. */
+    const lexer::regex_repetition& repetition() const
+    {
+      return m_repetition;
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    lexer::regex_ast_type m_type;
+    lexer::regex_charset m_set;
+    std::vector<std::unique_ptr<lexer::regex_ast>> m_children;
+    lexer::regex_repetition m_repetition;
+
+  };
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Convert a regular expression in postfix notation to a syntax tree.
+   */
+  std::unique_ptr<lexer::regex_ast> postfix_to_ast(const std::string& postfix);
+
+  /**
+   * Convert a regular expression to a syntax tree.
+   */
+  std::unique_ptr<lexer::regex_ast> regex_to_ast(const std::string& regex);
+
+  /**
+   * Convert a syntax tree to a regular expression in postfix notation.
+   */
+  std::string ast_to_postfix(const lexer::regex_ast& ast);
+
+  /**
+   * Returns `true` if two syntax trees are identical.
+   */
+  bool regex_ast_equal(const lexer::regex_ast& ast1, const lexer::regex_ast& ast2);
+
+  /**
+   * Rewrites a syntax tree into a smaller one matching the same strings.
+   *
+   * This and the other procedures on syntax trees walk them with explicit stacks rather than by
+   * recursion, so deeply nested regular expressions cannot overflow the call stack.
+   *
+   * The following rewrites are applied, from the bottom of the tree up:
+   *
+   * - Nested concatenations and alternations are flattened: `(ab)c` is `abc`, `(a|b)|c` is
+   *   `a|b|c`.
+   * - Nested repetition operators are collapsed: `(a*)*`, `(a+)*`, `(a?)+` etc. are all `a*`, and
+   *   bounded repetitions with equivalent operators are replaced: `a{0,1}` is `a?`.
+   * - Common prefixes of alternatives are factored out: `abc|abd` is `ab(c|d)`, and `a|ab` is
+   *   `ab?`. The longest prefix shared by a group of alternatives is factored out at once.
+   * - Single-character alternatives are merged into classes: `a|b|[0-9]` is `[ab0-9]`.
+   *
+   * @note
+   * The rewrites do not preserve the order of alternatives, so they must not be used where that
+   * order is significant (e.g., for submatch extraction).
+   */
+  std::unique_ptr<lexer::regex_ast> simplify_regex_ast(std::unique_ptr<lexer::regex_ast> ast);
+
+  /**
+   * Returns the postfix notation for the simplified syntax tree of a regular expression.
+   */
+  std::string regex_to_simplified_postfix(const std::string& regex);
+
+}
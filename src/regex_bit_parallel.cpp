@@ -0,0 +1,130 @@
+/**
+ * @file	regex_bit_parallel.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/15
+ */
+
+/* -- Includes -- */
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "regex_bit_parallel.hpp"
+#include "regex_glushkov.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Constants -- */
+
+const size_t regex_bit_parallel::max_positions = 64;
+
+namespace
+{
+
+  /** Number of bits in each chunk of the active set used to index the follow tables. */
+  const size_t chunk_bits = 8;
+
+  /** Number of entries in each follow table. */
+  const size_t chunk_size = (1 << chunk_bits);
+
+}
+
+/* -- Procedures -- */
+
+regex_bit_parallel::regex_bit_parallel(const regex_glushkov& glushkov)
+  : m_masks(),
+    m_first(0),
+    m_last(0),
+    m_nullable(glushkov.nullable()),
+    m_shift_and(true),
+    m_chunks((glushkov.size() + chunk_bits - 1) / chunk_bits),
+    m_follow()
+{
+  if (glushkov.size() > max_positions)
+  {
+    ostringstream message;
+    message << "Automaton has " << glushkov.size() << " positions, but at most "
+            << max_positions << " are supported!";
+    throw invalid_argument(message.str());
+  }
+
+  auto bit = [] (size_t pos) { return (mask_type(1) << pos); };
+
+  // positions entered by each byte
+  const auto& positions = glushkov.positions();
+  for (size_t pos = 0; pos < positions.size(); pos++)
+  {
+    for (size_t ch = 0; ch < m_masks.size(); ch++)
+    {
+      if (positions[pos].test(ch))
+        m_masks[ch] |= bit(pos);
+    }
+  }
+
+  for (auto pos : glushkov.first())
+    m_first |= bit(pos);
+  for (auto pos : glushkov.last())
+    m_last |= bit(pos);
+
+  // positions following each position, checking whether this is always the next one
+  const auto& follow = glushkov.follow();
+  vector<mask_type> follow_masks(follow.size(), 0);
+  for (size_t pos = 0; pos < follow.size(); pos++)
+  {
+    for (auto next : follow[pos])
+      follow_masks[pos] |= bit(next);
+    if (follow_masks[pos] != (pos + 1 < follow.size() ? bit(pos + 1) : 0))
+      m_shift_and = false;
+  }
+  if (m_shift_and)
+    return;
+
+  // follow tables for each chunk of the active set
+  m_follow.assign(m_chunks * chunk_size, 0);
+  for (size_t chunk = 0; chunk < m_chunks; chunk++)
+  {
+    auto* table = &m_follow[chunk * chunk_size];
+    for (size_t value = 1; value < chunk_size; value++)
+    {
+      // reuse the entry for this value without its lowest bit
+      auto low = __builtin_ctzll(value);
+      auto pos = chunk * chunk_bits + low;
+      auto mask = (pos < follow_masks.size() ? follow_masks[pos] : 0);
+      table[value] = table[value & (value - 1)] | mask;
+    }
+  }
+}
+
+bool regex_bit_parallel::match(const char* begin, const char* end) const
+{
+  if (m_nullable)
+    return true;
+  if (begin == end)
+    return false;
+
+  auto active = m_first & m_masks[static_cast<unsigned char>(*begin)];
+  for (auto it = begin + 1; ; it++)
+  {
+    if (active & m_last)
+      return true;
+    if (!active || it == end)
+      return false;
+
+    mask_type reachable = 0;
+    if (m_shift_and)
+      reachable = (active << 1);
+    else
+    {
+      for (size_t chunk = 0; chunk < m_chunks; chunk++)
+      {
+        auto value = (active >> (chunk * chunk_bits)) & (chunk_size - 1);
+        reachable |= m_follow[chunk * chunk_size + value];
+      }
+    }
+    active = reachable & m_masks[static_cast<unsigned char>(*it)];
+  }
+}
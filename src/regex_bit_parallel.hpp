@@ -0,0 +1,98 @@
+/**
+ * @file	regex_bit_parallel.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/15
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "regex_glushkov.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class which matches strings by simulating a small Glushkov automaton with bit operations.
+   *
+   * The set of active positions is kept in a single machine word, so each input byte costs a
+   * handful of shifts, lookups and ANDs, whatever the number of active positions:
+   *
+   * - If every position is only followed by the next one, this is the Shift-And algorithm, and the
+   *   positions reachable from the active set are simply the active set shifted left by one. This
+   *   is the case for a sequence of atoms in which only leading and trailing atoms are optional
+   *   (e.g. `a?bc?`), since those only change the first and last positions. An interior optional
+   *   atom (e.g. `ab?c`) lets a position skip to the one after next, so it uses the tables below.
+   *
+   * - Otherwise, the positions reachable from the active set are looked up in tables indexed by
+   *   each byte of the active set (Navarro and Raffinot), and ORed together.
+   *
+   * @note
+   * A `lexer::regex_bit_parallel` is immutable once constructed, and may be used by several
+   * threads.
+   */
+  class regex_bit_parallel
+  {
+
+    /* -- Typedefs -- */
+
+  public:
+
+    /** The type used to represent a set of positions. */
+    using mask_type = std::uint64_t;
+
+    /* -- Constants -- */
+
+  public:
+
+    /** The maximum number of positions supported. */
+    static const std::size_t max_positions;
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /**
+     * Constructs a new `lexer::regex_bit_parallel` instance for the specified automaton.
+     *
+     * @exception std::invalid_argument
+     * Thrown if the automaton has more than `max_positions` positions.
+     */
+    regex_bit_parallel(const lexer::regex_glushkov& glushkov);
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns `true` if this uses the Shift-And algorithm. */
+    bool is_shift_and() const
+    {
+      return m_shift_and;
+    }
+
+    /** Check if a match starts at the beginning of the specified range. */
+    bool match(const char* begin, const char* end) const;
+
+    /* -- Implementation -- */
+
+  private:
+
+    std::array<mask_type, 256> m_masks;
+    mask_type m_first;
+    mask_type m_last;
+    bool m_nullable;
+    bool m_shift_and;
+    std::size_t m_chunks;
+    std::vector<mask_type> m_follow;
+
+  };
+
+}
@@ -0,0 +1,122 @@
+/**
+ * @file	regex_cache.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/19
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "regex_cache.hpp"
+#include "regex_nfa.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Procedures -- */
+
+regex_cache& regex_cache::global()
+{
+  static regex_cache cache;
+  return cache;
+}
+
+regex_cache::regex_cache(size_t capacity)
+  : m_mutex(),
+    m_capacity(capacity),
+    m_hits(0),
+    m_misses(0),
+    m_entries(),
+    m_index()
+{
+}
+
+shared_ptr<const regex_nfa> regex_cache::get(const string& regex)
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    auto it = m_index.find(regex);
+    if (it != m_index.end())
+    {
+      // move the entry to the front of the list, since it is now the most recently used
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      m_hits++;
+      return it->second->second;
+    }
+    m_misses++;
+  }
+
+  auto nfa = make_shared<const regex_nfa>(regex_to_nfa(regex));
+
+  lock_guard<mutex> lock(m_mutex);
+  if (m_capacity == 0)
+    return nfa;
+
+  // another thread may have compiled the same expression in the meantime
+  auto it = m_index.find(regex);
+  if (it != m_index.end())
+  {
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->second;
+  }
+
+  m_entries.emplace_front(regex, nfa);
+  m_index.emplace(regex, m_entries.begin());
+  evict();
+  return nfa;
+}
+
+size_t regex_cache::capacity() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_capacity;
+}
+
+void regex_cache::set_capacity(size_t capacity)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_capacity = capacity;
+  evict();
+}
+
+size_t regex_cache::size() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+size_t regex_cache::hits() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_hits;
+}
+
+size_t regex_cache::misses() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_misses;
+}
+
+void regex_cache::clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+  m_hits = 0;
+  m_misses = 0;
+}
+
+void regex_cache::evict()
+{
+  // NFAs which are still in use elsewhere stay alive through their shared pointers
+  while (m_entries.size() > m_capacity)
+  {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+}
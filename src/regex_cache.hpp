@@ -0,0 +1,107 @@
+/**
+ * @file	regex_cache.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/19
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "regex_nfa.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing a least-recently-used cache of NFAs, keyed by regular expression.
+   *
+   * The cache holds at most `capacity` NFAs - when a new one is added to a full cache, the one
+   * which was used least recently is discarded. A capacity of zero disables the cache, so that
+   * every lookup compiles its regular expression.
+   *
+   * @note
+   * All methods may be called from any number of threads. Regular expressions are compiled
+   * outside of the cache's lock, so a slow compilation does not block lookups of other patterns.
+   */
+  class regex_cache
+  {
+
+    /* -- Constants -- */
+
+  public:
+
+    /** Default capacity for the process-wide cache. */
+    static const std::size_t default_capacity = 64;
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Returns the process-wide cache used by `lexer::regex_match`. */
+    static lexer::regex_cache& global();
+
+    /** Constructs a new `lexer::regex_cache` instance with the specified capacity. */
+    regex_cache(std::size_t capacity = default_capacity);
+
+    regex_cache(const regex_cache&) = delete;
+    regex_cache& operator=(const regex_cache&) = delete;
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /**
+     * Returns the NFA for the specified regular expression, compiling it if it is not cached.
+     *
+     * @exception std::runtime_error
+     * Thrown if the regular expression is invalid. Nothing is cached in this case.
+     */
+    std::shared_ptr<const lexer::regex_nfa> get(const std::string& regex);
+
+    /** Returns the maximum number of NFAs held by this cache. */
+    std::size_t capacity() const;
+
+    /** Sets the maximum number of NFAs held by this cache, discarding any which no longer fit. */
+    void set_capacity(std::size_t capacity);
+
+    /** Returns the number of NFAs currently held by this cache. */
+    std::size_t size() const;
+
+    /** Returns the number of lookups which found their NFA in the cache. */
+    std::size_t hits() const;
+
+    /** Returns the number of lookups which had to compile their NFA. */
+    std::size_t misses() const;
+
+    /** Discards all cached NFAs and resets the hit and miss counters. */
+    void clear();
+
+    /* -- Implementation -- */
+
+  private:
+
+    using entry = std::pair<std::string, std::shared_ptr<const lexer::regex_nfa>>;
+
+    void evict();
+
+    mutable std::mutex m_mutex;
+    std::size_t m_capacity;
+    std::size_t m_hits;
+    std::size_t m_misses;
+    std::list<entry> m_entries;
+    std::unordered_map<std::string, std::list<entry>::iterator> m_index;
+
+  };
+
+}
@@ -0,0 +1,325 @@
+/**
+ * @file	regex_charset.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/06
+ */
+
+/* -- Includes -- */
+
+#include <cctype>
+#include <stdexcept>
+#include <string>
+
+#include "diagnostic.hpp"
+#include "regex_charset.hpp"
+#include "regex_constants.hpp"
+#include "result.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Types -- */
+
+namespace
+{
+
+  /** Struct representing a parsed atom (or an element of a character class). */
+  struct parsed_atom
+  {
+    regex_charset set;
+    size_t length;
+  };
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns a diagnostic for a malformed atom at the specified position. */
+  diagnostic atom_error(diagnostic_kind kind, size_t pos)
+  {
+    return { kind, pos, 1, 0, static_cast<int>(pos) };
+  }
+
+  /** Returns a set containing all bytes in the specified inclusive range. */
+  regex_charset range_charset(unsigned char low, unsigned char high)
+  {
+    regex_charset set;
+    for (unsigned ch = low; ch <= high; ch++)
+      set.set(ch);
+    return set;
+  }
+
+  /** Returns a set containing all bytes for which the specified predicate is true. */
+  regex_charset predicate_charset(int (*predicate)(int))
+  {
+    regex_charset set;
+    for (unsigned ch = 0; ch < 128; ch++)
+    {
+      if (predicate(static_cast<int>(ch)))
+        set.set(ch);
+    }
+    return set;
+  }
+
+  /** Returns `true` if the byte is a "word" character. */
+  int is_word(int ch)
+  {
+    return (isalnum(ch) || ch == '_');
+  }
+
+  /** Returns the value of a hexadecimal digit, or -1 if it is not one. */
+  int hex_value(char ch)
+  {
+    if (ch >= '0' && ch <= '9')
+      return ch - '0';
+    else if (ch >= 'a' && ch <= 'f')
+      return ch - 'a' + 10;
+    else if (ch >= 'A' && ch <= 'F')
+      return ch - 'A' + 10;
+    else
+      return -1;
+  }
+
+  /** Parses an escape sequence starting at the specified position. */
+  result<parsed_atom> parse_escape(const string& regex, size_t pos)
+  {
+    if (pos + 1 >= regex.size())
+      return atom_error(diagnostic_kind::regex_dangling_escape, pos);
+
+    parsed_atom atom;
+    atom.length = 2;
+
+    char ch = regex[pos + 1];
+    switch (ch)
+    {
+    case 'd':
+    case 'D':
+      atom.set = range_charset('0', '9');
+      break;
+    case 's':
+    case 'S':
+      atom.set = predicate_charset(isspace);
+      break;
+    case 'w':
+    case 'W':
+      atom.set = predicate_charset(is_word);
+      break;
+    case 'n':
+      atom.set.set('\n');
+      break;
+    case 't':
+      atom.set.set('\t');
+      break;
+    case 'r':
+      atom.set.set('\r');
+      break;
+    case 'f':
+      atom.set.set('\f');
+      break;
+    case 'v':
+      atom.set.set('\v');
+      break;
+    case 'x':
+    {
+      int high = (pos + 2 < regex.size() ? hex_value(regex[pos + 2]) : -1);
+      int low = (pos + 3 < regex.size() ? hex_value(regex[pos + 3]) : -1);
+      if (high < 0 || low < 0)
+        return atom_error(diagnostic_kind::regex_invalid_hex_escape, pos);
+      atom.set.set(static_cast<size_t>(high * 16 + low));
+      atom.length = 4;
+      break;
+    }
+    default:
+      atom.set.set(static_cast<unsigned char>(ch));
+      break;
+    }
+
+    // upper case class escapes are negated
+    if (ch == 'D' || ch == 'S' || ch == 'W')
+      atom.set.flip();
+
+    return atom;
+  }
+
+  /** Parses a single (non-range) element of a character class. */
+  result<parsed_atom> parse_class_element(const string& regex, size_t pos)
+  {
+    if (regex[pos] == regex_constants::escape)
+      return parse_escape(regex, pos);
+
+    parsed_atom atom;
+    atom.set.set(static_cast<unsigned char>(regex[pos]));
+    atom.length = 1;
+    return atom;
+  }
+
+  /** Returns the only byte in a set containing exactly one byte. */
+  unsigned char single_byte(const regex_charset& set)
+  {
+    size_t ch = 0;
+    while (!set.test(ch))
+      ch++;
+    return static_cast<unsigned char>(ch);
+  }
+
+  /** Parses a character class starting at the specified position. */
+  result<parsed_atom> parse_class(const string& regex, size_t pos)
+  {
+    parsed_atom atom;
+    size_t idx = pos + 1;
+
+    bool negate = (idx < regex.size() && regex[idx] == regex_constants::negate_class);
+    if (negate)
+      idx++;
+
+    // a close bracket is literal if it is the first character in the class
+    bool first = true;
+    while (true)
+    {
+      if (idx >= regex.size())
+        return atom_error(diagnostic_kind::regex_unterminated_class, pos);
+      if (regex[idx] == regex_constants::close_class && !first)
+        break;
+      first = false;
+
+      auto parsed = parse_class_element(regex, idx);
+      if (!parsed)
+        return parsed.error();
+      auto& element = parsed.value();
+      idx += element.length;
+
+      // check for a range, unless the separator is the last character in the class
+      if (idx + 1 < regex.size() &&
+          regex[idx] == regex_constants::class_range &&
+          regex[idx + 1] != regex_constants::close_class)
+      {
+        auto high = parse_class_element(regex, idx + 1);
+        if (!high)
+          return high.error();
+        const auto& high_set = high.value().set;
+        if (element.set.count() != 1 || high_set.count() != 1 ||
+            single_byte(element.set) > single_byte(high_set))
+          return atom_error(diagnostic_kind::regex_invalid_class_range, idx);
+        element.set = range_charset(single_byte(element.set), single_byte(high_set));
+        idx += 1 + high.value().length;
+      }
+
+      atom.set |= element.set;
+    }
+
+    if (negate)
+      atom.set.flip();
+    atom.length = idx + 1 - pos;
+    return atom;
+  }
+
+  /** Appends the representation of a single byte to an atom. */
+  void append_byte(string& atom, unsigned char ch)
+  {
+    static const char digits[] = "0123456789abcdef";
+    if (isalnum(ch))
+      atom.push_back(static_cast<char>(ch));
+    else
+    {
+      atom.push_back(regex_constants::escape);
+      atom.push_back('x');
+      atom.push_back(digits[ch >> 4]);
+      atom.push_back(digits[ch & 0x0f]);
+    }
+  }
+
+  /** Parses the atom starting at the specified position. */
+  result<parsed_atom> parse_atom(const string& regex, size_t pos)
+  {
+    if (regex[pos] == regex_constants::escape)
+      return parse_escape(regex, pos);
+    else if (regex[pos] == regex_constants::open_class)
+      return parse_class(regex, pos);
+
+    parsed_atom atom;
+    atom.set.set(static_cast<unsigned char>(regex[pos]));
+    atom.length = 1;
+    return atom;
+  }
+
+  /** Parses the atom starting at the specified position, throwing if it is invalid. */
+  parsed_atom parse_valid_atom(const string& regex, size_t pos)
+  {
+    auto atom = parse_atom(regex, pos);
+    if (!atom)
+      throw runtime_error(diagnostic_message(atom.error(), regex));
+    return atom.value();
+  }
+
+}
+
+/* -- Procedures -- */
+
+size_t lexer::regex_atom_length(const string& regex, size_t pos)
+{
+  return parse_valid_atom(regex, pos).length;
+}
+
+regex_charset lexer::regex_atom_charset(const string& regex, size_t pos)
+{
+  return parse_valid_atom(regex, pos).set;
+}
+
+regex_charset lexer::regex_atom_charset(const string& regex, size_t pos, size_t& length)
+{
+  auto atom = parse_valid_atom(regex, pos);
+  length = atom.length;
+  return atom.set;
+}
+
+result<regex_charset> lexer::try_regex_atom_charset(const string& regex,
+                                                    size_t pos,
+                                                    size_t& length)
+{
+  auto atom = parse_atom(regex, pos);
+  if (!atom)
+    return atom.error();
+  length = atom.value().length;
+  return atom.value().set;
+}
+
+string lexer::regex_charset_atom(const regex_charset& set)
+{
+  if (set.none())
+    throw invalid_argument("Cannot represent an empty set as an atom!");
+
+  string atom;
+  if (set.count() == 1)
+  {
+    append_byte(atom, single_byte(set));
+    return atom;
+  }
+
+  // write each run of consecutive bytes as a range
+  atom.push_back(regex_constants::open_class);
+  for (size_t low = 0; low < set.size(); low++)
+  {
+    if (!set.test(low))
+      continue;
+
+    auto high = low;
+    while (high + 1 < set.size() && set.test(high + 1))
+      high++;
+
+    append_byte(atom, static_cast<unsigned char>(low));
+    if (high > low)
+    {
+      if (high > low + 1)
+        atom.push_back(regex_constants::class_range);
+      append_byte(atom, static_cast<unsigned char>(high));
+    }
+    low = high;
+  }
+  atom.push_back(regex_constants::close_class);
+  return atom;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file	regex_charset.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/06
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <bitset>
+#include <cstddef>
+#include <string>
+
+#include "result.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Type representing a set of bytes matched by a single transition.
+   */
+  using regex_charset = std::bitset<256>;
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Returns the length of the atom starting at the specified position.
+   *
+   * An atom is a single character, an escape sequence (`\d`, `\s`, `\w`, their negations, `\n`,
+   * `\t`, `\r`, `\f`, `\v`, `\xHH`, or a backslash followed by any other character to match it
+   * literally), or a character class (`[a-z_]`, `[^0-9]`).
+   */
+  std::size_t regex_atom_length(const std::string& regex, std::size_t pos);
+
+  /**
+   * Returns the set of bytes matched by the atom starting at the specified position.
+   */
+  lexer::regex_charset regex_atom_charset(const std::string& regex, std::size_t pos);
+
+  /**
+   * Returns the set of bytes matched by the atom starting at the specified position, and sets
+   * `length` to the length of the atom.
+   */
+  lexer::regex_charset regex_atom_charset(const std::string& regex,
+                                          std::size_t pos,
+                                          std::size_t& length);
+
+  /**
+   * Parses the atom starting at the specified position like `lexer::regex_atom_charset`, but
+   * returns a diagnostic rather than throwing if it is invalid.
+   */
+  lexer::result<lexer::regex_charset> try_regex_atom_charset(const std::string& regex,
+                                                             std::size_t pos,
+                                                             std::size_t& length);
+
+  /**
+   * Returns an atom matching exactly the bytes in the specified (non-empty) set.
+   *
+   * Letters and digits are written as themselves, and all other bytes as `\xHH` escapes, so the
+   * result can be used in a regular expression or in postfix notation.
+   */
+  std::string regex_charset_atom(const lexer::regex_charset& set);
+
+}
@@ -28,11 +28,47 @@ namespace lexer
     /** Repeat operator. */
     const char repeat_op = '+';
 
+    /** Open bounded repetition operator (`{m}`, `{m,}` or `{m,n}`). */
+    const char open_repetition_op = '{';
+
+    /** Close bounded repetition operator. */
+    const char close_repetition_op = '}';
+
+    /** Bounded repetition count separator. */
+    const char repetition_separator = ',';
+
     /** Open bracket. */
     const char open_bracket = '(';
 
     /** Close bracket. */
     const char close_bracket = ')';
 
+    /** Escape character. */
+    const char escape = '\\';
+
+    /** Open character class. */
+    const char open_class = '[';
+
+    /** Close character class. */
+    const char close_class = ']';
+
+    /** Negated character class marker (first character of a class). */
+    const char negate_class = '^';
+
+    /** Character class range separator. */
+    const char class_range = '-';
+
+    /**
+     * Wildcard (any character except newline).
+     *
+     * @note
+     * This is the same character as `concat_op`. It is only a wildcard in a regular expression; in
+     * postfix notation it is written as the equivalent character class, `any_class`.
+     */
+    const char any = '.';
+
+    /** Character class equivalent to the wildcard, used in postfix notation. */
+    const char any_class[] = "[^\\n]";
+
   }
 }
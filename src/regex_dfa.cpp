@@ -0,0 +1,437 @@
+/**
+ * @file	regex_dfa.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/04
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "regex_charset.hpp"
+#include "regex_dfa.hpp"
+#include "regex_nfa.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Constants -- */
+
+const size_t regex_dfa::alphabet_size = 256;
+const regex_dfa::state_type regex_dfa::dead_state = 0;
+const regex_dfa::tag_type regex_dfa::no_tag = -1;
+
+namespace
+{
+
+  /** Maximum number of states we will generate before giving up. */
+  const size_t max_dfa_states = 100000;
+
+}
+
+/* -- Private Types -- */
+
+namespace
+{
+
+  /** Struct holding the tables for a `lexer::regex_dfa` which owns its own storage. */
+  struct owned_tables
+  {
+    vector<uint8_t> classes;
+    vector<regex_dfa::state_type> transitions;
+    vector<regex_dfa::tag_type> tags;
+  };
+
+  /**
+   * Class implementing the subset construction.
+   *
+   * Fragments of all of the input NFAs are numbered in a single index space, so that a DFA state
+   * can be keyed by a sorted vector of fragment numbers.
+   */
+  class subset_construction
+  {
+  public:
+
+    /** Constructs the DFA for the specified NFAs. */
+    subset_construction(const vector<const regex_nfa*>& nfas)
+      : m_classes(nfa_byte_classes(nfas)),
+        m_class_count(*max_element(m_classes.begin(), m_classes.end()) + 1u),
+        m_nfas(nfas)
+    {
+      // pick a representative byte for each class
+      vector<unsigned char> representatives(m_class_count);
+      for (size_t ch = regex_dfa::alphabet_size; ch-- > 0; )
+        representatives[m_classes[ch]] = static_cast<unsigned char>(ch);
+
+      for (size_t idx = 0; idx < nfas.size(); idx++)
+      {
+        m_offsets.push_back(m_fragments.size());
+        m_closures.emplace_back(*nfas[idx]);
+        for (const auto& frag : nfas[idx]->fragments())
+        {
+          m_fragments.push_back(frag.get());
+          m_tags.push_back(static_cast<regex_dfa::tag_type>(idx));
+        }
+      }
+
+      // state 0 is always the dead state
+      add_state(set_type());
+
+      // the start state contains the closure of every NFA's head
+      set_type heads;
+      for (size_t idx = 0; idx < nfas.size(); idx++)
+        heads.push_back(m_offsets[idx] + nfas[idx]->head()->index);
+      m_start = add_state(closure(heads));
+
+      // keep going until every state has been processed
+      for (regex_dfa::state_type state = 0; state < m_sets.size(); state++)
+      {
+        for (auto ch : representatives)
+        {
+          set_type next;
+          for (auto number : m_sets[state])
+          {
+            const auto* frag = m_fragments[number];
+            if (frag->is_symbol() && frag->link1.matches(ch))
+              next.push_back(number - frag->index + frag->link1.output->index);
+          }
+          m_transitions.push_back(add_state(closure(next)));
+        }
+      }
+    }
+
+    /** Returns the completed DFA. */
+    regex_dfa dfa()
+    {
+      return regex_dfa(move(m_classes),
+                       m_class_count,
+                       move(m_transitions),
+                       move(m_state_tags),
+                       m_start);
+    }
+
+  private:
+
+    using set_type = vector<size_t>;
+
+    /**
+     * Returns the union of the epsilon closures of the specified fragments, which must each be the
+     * head of an NFA or the output of a symbol link.
+     *
+     * @note
+     * Epsilon fragments are not part of any closure, since they do not affect which transitions
+     * are available. This keeps equivalent sets from producing duplicate states.
+     */
+    set_type closure(const set_type& entries)
+    {
+      set_type result;
+      for (auto& closure : m_closures)
+        closure.clear();
+      for (auto number : entries)
+      {
+        const auto* frag = m_fragments[number];
+        auto offset = number - frag->index;
+        m_closures[m_tags[number]].add(frag, [&] (size_t index) {
+            result.push_back(offset + index);
+          });
+      }
+      sort(result.begin(), result.end());
+      return result;
+    }
+
+    /** Returns the state for the specified set, adding it if it does not already exist. */
+    regex_dfa::state_type add_state(set_type set)
+    {
+      auto it = m_states.find(set);
+      if (it != m_states.end())
+        return it->second;
+
+      if (m_sets.size() >= max_dfa_states)
+        throw runtime_error("Regular expression DFA is too large!");
+
+      auto tag = regex_dfa::no_tag;
+      for (auto number : set)
+      {
+        if (m_fragments[number]->is_terminal() && (tag == regex_dfa::no_tag || m_tags[number] < tag))
+          tag = m_tags[number];
+      }
+
+      auto state = static_cast<regex_dfa::state_type>(m_sets.size());
+      m_states.emplace(set, state);
+      m_sets.push_back(move(set));
+      m_state_tags.push_back(tag);
+      return state;
+    }
+
+    vector<uint8_t> m_classes;
+    size_t m_class_count;
+    vector<const regex_nfa_fragment*> m_fragments;
+    vector<regex_dfa::tag_type> m_tags;
+    vector<const regex_nfa*> m_nfas;
+    vector<size_t> m_offsets;
+    vector<regex_nfa_closure> m_closures;
+    map<set_type, regex_dfa::state_type> m_states;
+    vector<set_type> m_sets;
+    vector<regex_dfa::state_type> m_transitions;
+    vector<regex_dfa::tag_type> m_state_tags;
+    regex_dfa::state_type m_start;
+
+  };
+
+  /**
+   * Class implementing the construction of a DFA which finds the end of the leftmost-first match
+   * anywhere in its input.
+   *
+   * This is the subset construction with two differences. First, the sets of fragments are kept in
+   * priority order (the order a Pike VM would keep its threads in), with the threads starting at
+   * later positions after all of the others. Second, once a set contains the terminal fragment, the
+   * fragments after it are dropped and no new threads are started, since any match they found
+   * would have a lower priority. Each state is therefore keyed by the ordered list of fragments and
+   * by whether new threads are still being started.
+   */
+  class search_construction
+  {
+  public:
+
+    /** Constructs the search DFA for the specified NFA. */
+    search_construction(const regex_nfa& nfa)
+      : m_classes(nfa_byte_classes({ &nfa })),
+        m_class_count(*max_element(m_classes.begin(), m_classes.end()) + 1u),
+        m_nfa(nfa),
+        m_closure(nfa)
+    {
+      vector<unsigned char> representatives(m_class_count);
+      for (size_t ch = regex_dfa::alphabet_size; ch-- > 0; )
+        representatives[m_classes[ch]] = static_cast<unsigned char>(ch);
+
+      // state 0 is always the dead state, which has no fragments and starts no threads
+      add_state(false, { });
+      m_start = add_state(true, { });
+
+      const auto& fragments = m_nfa.fragments();
+      vector<const regex_nfa_fragment*> entries;
+      for (regex_dfa::state_type state = 0; state < m_sets.size(); state++)
+      {
+        for (auto ch : representatives)
+        {
+          entries.clear();
+          for (auto index : m_sets[state].second)
+          {
+            const auto* frag = fragments[index].get();
+            if (frag->is_symbol() && frag->link1.matches(ch))
+              entries.push_back(frag->link1.output);
+          }
+          m_transitions.push_back(add_state(m_sets[state].first, entries));
+        }
+      }
+    }
+
+    /** Returns the completed DFA. */
+    regex_dfa dfa()
+    {
+      return regex_dfa(move(m_classes),
+                       m_class_count,
+                       move(m_transitions),
+                       move(m_state_tags),
+                       m_start);
+    }
+
+  private:
+
+    using key_type = pair<bool, vector<size_t>>;
+
+    /**
+     * Returns the state for the closures of the specified fragments, followed by the closure of
+     * the head if new threads are still being started, adding the state if necessary.
+     */
+    regex_dfa::state_type add_state(bool searching, const vector<const regex_nfa_fragment*>& entries)
+    {
+      key_type key { searching, { } };
+      auto& set = key.second;
+      bool matched = false;
+
+      // local procedure to append the closure of a fragment, stopping at the terminal fragment
+      auto append = [&] (const regex_nfa_fragment* entry) {
+        m_closure.add(entry, [&] (size_t index) {
+            if (matched)
+              return;
+            set.push_back(index);
+            matched = m_nfa.fragments()[index]->is_terminal();
+          });
+      };
+
+      m_closure.clear();
+      for (const auto* entry : entries)
+        append(entry);
+      if (searching)
+        append(m_nfa.head());
+
+      // once a match has been found, later threads can never win
+      if (matched)
+        key.first = false;
+
+      auto it = m_states.find(key);
+      if (it != m_states.end())
+        return it->second;
+
+      if (m_sets.size() >= max_dfa_states)
+        throw runtime_error("Regular expression DFA is too large!");
+
+      auto state = static_cast<regex_dfa::state_type>(m_sets.size());
+      m_states.emplace(key, state);
+      m_sets.push_back(move(key));
+      m_state_tags.push_back(matched ? 0 : regex_dfa::no_tag);
+      return state;
+    }
+
+    vector<uint8_t> m_classes;
+    size_t m_class_count;
+    const regex_nfa& m_nfa;
+    regex_nfa_closure m_closure;
+    map<key_type, regex_dfa::state_type> m_states;
+    vector<key_type> m_sets;
+    vector<regex_dfa::state_type> m_transitions;
+    vector<regex_dfa::tag_type> m_state_tags;
+    regex_dfa::state_type m_start;
+
+  };
+
+}
+
+/* -- Procedures -- */
+
+regex_dfa::regex_dfa(vector<uint8_t> classes,
+                     size_t class_count,
+                     vector<state_type> transitions,
+                     vector<tag_type> tags,
+                     state_type start)
+  : m_class_count(class_count),
+    m_state_count(tags.size()),
+    m_start(start)
+{
+  auto tables = make_shared<owned_tables>();
+  tables->classes = move(classes);
+  tables->transitions = move(transitions);
+  tables->tags = move(tags);
+
+  m_classes = tables->classes.data();
+  m_transitions = tables->transitions.data();
+  m_tags = tables->tags.data();
+  m_storage = move(tables);
+}
+
+regex_dfa::regex_dfa(shared_ptr<const void> storage,
+                     const uint8_t* classes,
+                     size_t class_count,
+                     const state_type* transitions,
+                     const tag_type* tags,
+                     size_t state_count,
+                     state_type start)
+  : m_storage(move(storage)),
+    m_classes(classes),
+    m_class_count(class_count),
+    m_transitions(transitions),
+    m_tags(tags),
+    m_state_count(state_count),
+    m_start(start)
+{
+}
+
+vector<uint8_t> lexer::nfa_byte_classes(const vector<const regex_nfa*>& nfas)
+{
+  // collect the distinct sets of bytes accepted by each symbol link
+  vector<regex_charset> sets;
+  for (const auto* nfa : nfas)
+  {
+    for (const auto& frag : nfa->fragments())
+    {
+      if (!frag->is_symbol())
+        continue;
+      auto set = frag->link1.charset();
+      if (find(sets.begin(), sets.end(), set) == sets.end())
+        sets.push_back(set);
+    }
+  }
+
+  // start with every byte in one class, then split each class by membership in each set
+  vector<uint8_t> classes(regex_dfa::alphabet_size, 0);
+  for (const auto& set : sets)
+  {
+    // new class numbers, indexed by (old class, is member)
+    vector<int> split(2 * regex_dfa::alphabet_size, -1);
+    int count = 0;
+    for (size_t ch = 0; ch < regex_dfa::alphabet_size; ch++)
+    {
+      auto& number = split[2 * classes[ch] + (set[ch] ? 1 : 0)];
+      if (number < 0)
+        number = count++;
+      classes[ch] = static_cast<uint8_t>(number);
+    }
+  }
+
+  return classes;
+}
+
+regex_dfa lexer::nfa_to_dfa(const vector<const regex_nfa*>& nfas)
+{
+  subset_construction construction(nfas);
+  return construction.dfa();
+}
+
+regex_dfa lexer::nfa_to_search_dfa(const regex_nfa& nfa)
+{
+  search_construction construction(nfa);
+  return construction.dfa();
+}
+
+regex_dfa lexer::regex_to_dfa(const string& regex)
+{
+  regex_nfa nfa = regex_to_nfa(regex);
+  return nfa_to_dfa({ &nfa });
+}
+
+regex_dfa lexer::regexes_to_dfa(const vector<string>& regexes)
+{
+  vector<regex_nfa> nfas;
+  nfas.reserve(regexes.size());
+  for (const auto& regex : regexes)
+    nfas.push_back(regex_to_nfa(regex));
+
+  vector<const regex_nfa*> pointers;
+  for (const auto& nfa : nfas)
+    pointers.push_back(&nfa);
+
+  return nfa_to_dfa(pointers);
+}
+
+bool lexer::regex_match(const regex_dfa& dfa, const string& str)
+{
+  return regex_match(dfa, str.data(), str.data() + str.size());
+}
+
+bool lexer::regex_match(const regex_dfa& dfa, const char* begin, const char* end)
+{
+  auto state = dfa.start();
+  if (dfa.tag(state) != regex_dfa::no_tag)
+    return true;
+
+  for (auto it = begin; it != end; it++)
+  {
+    state = dfa.next(state, static_cast<unsigned char>(*it));
+    if (dfa.tag(state) != regex_dfa::no_tag)
+      return true;
+    if (dfa.is_dead(state))
+      return false;
+  }
+
+  return false;
+}
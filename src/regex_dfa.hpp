@@ -0,0 +1,217 @@
+/**
+ * @file	regex_dfa.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/04
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "regex_nfa.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing a deterministic finite automaton for one or more regular expressions.
+   *
+   * @note
+   * The automaton is stored as flat arrays, so that it can be written to a file and mapped back
+   * into memory without any parsing (see `regex_dfa_file.hpp`). The tables are immutable once
+   * constructed, and copies of a `lexer::regex_dfa` share the same tables.
+   */
+  class regex_dfa
+  {
+
+    /* -- Typedefs -- */
+
+  public:
+
+    /** The type used to represent a state. */
+    using state_type = std::uint32_t;
+
+    /** The type used to represent an accept tag (the index of the accepted pattern). */
+    using tag_type = std::int32_t;
+
+    /* -- Constants -- */
+
+  public:
+
+    /** The number of distinct input bytes. */
+    static const std::size_t alphabet_size;
+
+    /** The state which can never reach an accepting state. This is always state 0. */
+    static const state_type dead_state;
+
+    /** Tag for states which do not accept any pattern. */
+    static const tag_type no_tag;
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_dfa` instance which owns the specified tables. */
+    regex_dfa(std::vector<std::uint8_t> classes,
+              std::size_t class_count,
+              std::vector<state_type> transitions,
+              std::vector<tag_type> tags,
+              state_type start);
+
+    /**
+     * Constructs a new `lexer::regex_dfa` instance referencing external tables.
+     *
+     * @note
+     * The tables are not copied. `storage` is retained for the lifetime of the DFA (and any copies
+     * of it), and must keep the tables valid.
+     */
+    regex_dfa(std::shared_ptr<const void> storage,
+              const std::uint8_t* classes,
+              std::size_t class_count,
+              const state_type* transitions,
+              const tag_type* tags,
+              std::size_t state_count,
+              state_type start);
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the start state. */
+    state_type start() const
+    {
+      return m_start;
+    }
+
+    /**
+     * Returns the state reached from `state` on the input byte `ch`.
+     *
+     * @note
+     * The transition table is indexed by byte class (see `lexer::nfa_byte_classes`) rather than
+     * by byte, so each row only has `class_count()` entries.
+     */
+    state_type next(state_type state, unsigned char ch) const
+    {
+      return m_transitions[state * m_class_count + m_classes[ch]];
+    }
+
+    /** Returns the accept tag for the specified state, or `no_tag` if it is not accepting. */
+    tag_type tag(state_type state) const
+    {
+      return m_tags[state];
+    }
+
+    /** Returns `true` if the specified state is the dead state. */
+    bool is_dead(state_type state) const
+    {
+      return (state == dead_state);
+    }
+
+    /** Returns the number of states in this DFA. */
+    std::size_t state_count() const
+    {
+      return m_state_count;
+    }
+
+    /** Returns the number of byte classes indexing the transition table. */
+    std::size_t class_count() const
+    {
+      return m_class_count;
+    }
+
+    /** Returns the byte-to-class map (`alphabet_size` entries). */
+    const std::uint8_t* classes() const
+    {
+      return m_classes;
+    }
+
+    /** Returns the transition table (`state_count() * class_count()` entries). */
+    const state_type* transitions() const
+    {
+      return m_transitions;
+    }
+
+    /** Returns the accept tag table (`state_count()` entries). */
+    const tag_type* tags() const
+    {
+      return m_tags;
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    std::shared_ptr<const void> m_storage;
+    const std::uint8_t* m_classes;
+    std::size_t m_class_count;
+    const state_type* m_transitions;
+    const tag_type* m_tags;
+    std::size_t m_state_count;
+    state_type m_start;
+
+  };
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Computes the byte classes (alphabet compression) for one or more NFAs.
+   *
+   * Bytes which no transition in any of the NFAs distinguishes are put in the same class, so the
+   * DFA transition table only needs one column per class instead of one per byte. The result maps
+   * each byte to its class, numbered from 0 in order of each class's lowest byte.
+   */
+  std::vector<std::uint8_t> nfa_byte_classes(const std::vector<const lexer::regex_nfa*>& nfas);
+
+  /**
+   * Converts one or more NFAs to a single DFA using the subset construction.
+   *
+   * @note
+   * States accepting the NFA at index `n` are tagged with `n`. If a state accepts more than one
+   * NFA, the lowest index wins.
+   */
+  lexer::regex_dfa nfa_to_dfa(const std::vector<const lexer::regex_nfa*>& nfas);
+
+  /**
+   * Converts an NFA to a DFA which finds the end of the leftmost-first match anywhere in its input.
+   *
+   * Unlike `lexer::nfa_to_dfa`, the DFA is unanchored: it keeps starting new matches until one is
+   * found, and then keeps running only as long as a match with a higher priority (as reported by
+   * `lexer::regex_pike_vm`) might still be found. Accepting states are tagged with 0, so the end
+   * of the match is the position of the last accepting state reached before the dead state.
+   */
+  lexer::regex_dfa nfa_to_search_dfa(const lexer::regex_nfa& nfa);
+
+  /**
+   * Converts a regular expression to a DFA.
+   */
+  lexer::regex_dfa regex_to_dfa(const std::string& regex);
+
+  /**
+   * Converts a list of regular expressions to a single tagged DFA.
+   */
+  lexer::regex_dfa regexes_to_dfa(const std::vector<std::string>& regexes);
+
+  /**
+   * Check if a string matches the DFA.
+   */
+  bool regex_match(const lexer::regex_dfa& dfa, const std::string& str);
+
+  /**
+   * Check if the characters in the specified range match the DFA.
+   */
+  bool regex_match(const lexer::regex_dfa& dfa, const char* begin, const char* end);
+
+}
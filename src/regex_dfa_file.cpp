@@ -0,0 +1,186 @@
+/**
+ * @file	regex_dfa_file.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/04
+ */
+
+/* -- Includes -- */
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "regex_dfa.hpp"
+#include "regex_dfa_file.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Types -- */
+
+namespace
+{
+
+  /** Header at the start of a precompiled DFA file. */
+  struct file_header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order_mark;
+    uint32_t state_count;
+    uint32_t class_count;
+    uint32_t start;
+    uint32_t reserved;
+  };
+
+  static_assert(sizeof(file_header) == 32, "Unexpected file header size!");
+
+  /** Offset of the byte class map in the file. */
+  const size_t classes_offset = sizeof(file_header);
+
+  /** Offset of the transition table in the file. */
+  const size_t transitions_offset = classes_offset + 256;
+
+  /** Class owning a read-only memory mapping of a file. */
+  class file_mapping
+  {
+  public:
+
+    file_mapping(void* data, size_t size)
+      : m_data(data),
+        m_size(size)
+    { }
+
+    ~file_mapping()
+    {
+      munmap(m_data, m_size);
+    }
+
+    file_mapping(const file_mapping&) = delete;
+    file_mapping& operator=(const file_mapping&) = delete;
+
+    const uint8_t* data() const
+    {
+      return static_cast<const uint8_t*>(m_data);
+    }
+
+  private:
+
+    void* m_data;
+    size_t m_size;
+
+  };
+
+  /** Throws an exception describing a problem with the specified file. */
+  [[noreturn]] void throw_file_error(const string& path, const string& problem)
+  {
+    ostringstream message;
+    message << "Cannot load DFA from \"" << path << "\": " << problem;
+    throw runtime_error(message.str());
+  }
+
+}
+
+/* -- Procedures -- */
+
+void lexer::save_regex_dfa(const regex_dfa& dfa, const string& path)
+{
+  file_header header;
+  memcpy(header.magic, regex_dfa_file::magic, sizeof(header.magic));
+  header.version = regex_dfa_file::version;
+  header.byte_order_mark = regex_dfa_file::byte_order_mark;
+  header.state_count = static_cast<uint32_t>(dfa.state_count());
+  header.class_count = static_cast<uint32_t>(dfa.class_count());
+  header.start = dfa.start();
+  header.reserved = 0;
+
+  ofstream file(path, ios::binary | ios::trunc);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(dfa.classes()),
+             regex_dfa::alphabet_size * sizeof(uint8_t));
+  file.write(reinterpret_cast<const char*>(dfa.transitions()),
+             dfa.state_count() * dfa.class_count() * sizeof(regex_dfa::state_type));
+  file.write(reinterpret_cast<const char*>(dfa.tags()),
+             dfa.state_count() * sizeof(regex_dfa::tag_type));
+
+  if (!file)
+  {
+    ostringstream message;
+    message << "Cannot write DFA to \"" << path << "\".";
+    throw runtime_error(message.str());
+  }
+}
+
+regex_dfa lexer::load_regex_dfa(const string& path)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw_file_error(path, "file could not be opened.");
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < transitions_offset)
+  {
+    close(fd);
+    throw_file_error(path, "file is truncated.");
+  }
+
+  auto size = static_cast<size_t>(info.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    throw_file_error(path, "file could not be mapped.");
+  auto mapping = make_shared<file_mapping>(data, size);
+
+  file_header header;
+  memcpy(&header, mapping->data(), sizeof(header));
+  if (memcmp(header.magic, regex_dfa_file::magic, sizeof(header.magic)) != 0)
+    throw_file_error(path, "file is not a precompiled DFA.");
+  if (header.version != regex_dfa_file::version)
+    throw_file_error(path, "unsupported file version.");
+  if (header.byte_order_mark != regex_dfa_file::byte_order_mark)
+    throw_file_error(path, "file was written with a different byte order.");
+  if (header.class_count == 0 ||
+      header.class_count > regex_dfa::alphabet_size ||
+      header.start >= header.state_count)
+    throw_file_error(path, "header is invalid.");
+
+  auto cells = static_cast<size_t>(header.state_count) * header.class_count;
+  auto tags_offset = transitions_offset + cells * sizeof(regex_dfa::state_type);
+  if (size != tags_offset + header.state_count * sizeof(regex_dfa::tag_type))
+    throw_file_error(path, "file size does not match header.");
+
+  // every byte class and transition is used as an index while matching, so a corrupt table must
+  // be rejected here rather than read out of bounds later
+  const auto* classes = mapping->data() + classes_offset;
+  for (size_t ch = 0; ch < regex_dfa::alphabet_size; ch++)
+  {
+    if (classes[ch] >= header.class_count)
+      throw_file_error(path, "byte class map is invalid.");
+  }
+  const auto* transitions =
+    reinterpret_cast<const regex_dfa::state_type*>(mapping->data() + transitions_offset);
+  for (size_t cell = 0; cell < cells; cell++)
+  {
+    if (transitions[cell] >= header.state_count)
+      throw_file_error(path, "transition table is invalid.");
+  }
+
+  return regex_dfa(mapping,
+                   classes,
+                   header.class_count,
+                   transitions,
+                   reinterpret_cast<const regex_dfa::tag_type*>(mapping->data() + tags_offset),
+                   header.state_count,
+                   header.start);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file	regex_dfa_file.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/04
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstdint>
+#include <string>
+
+#include "regex_dfa.hpp"
+
+/* -- Constants -- */
+
+namespace lexer
+{
+  namespace regex_dfa_file
+  {
+
+    /** Magic bytes at the start of every precompiled DFA file. */
+    const char magic[8] = { 'l', 'e', 'x', 'e', 'r', 'd', 'f', 'a' };
+
+    /** Current version of the file format. */
+    const std::uint32_t version = 1;
+
+    /** Value written to detect files from a machine with a different byte order. */
+    const std::uint32_t byte_order_mark = 0x01020304;
+
+  }
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Writes a DFA to the specified file.
+   *
+   * The file consists of a fixed-size header followed by the tables of the DFA, stored exactly as
+   * they are laid out in memory:
+   *
+   *     header         32 bytes: magic, version, byte order mark, state count, class count,
+   *                    start state, reserved
+   *     classes        256 x uint8
+   *     transitions    state count x class count x uint32
+   *     tags           state count x int32
+   */
+  void save_regex_dfa(const lexer::regex_dfa& dfa, const std::string& path);
+
+  /**
+   * Loads a DFA from the specified file.
+   *
+   * @note
+   * The file is mapped into memory read-only and used in place, so nothing is copied. The header,
+   * byte class map and transition table are validated, which takes a single pass over the tables.
+   *
+   * @exception std::runtime_error
+   * Thrown if the file cannot be read, or is not a valid precompiled DFA.
+   */
+  lexer::regex_dfa load_regex_dfa(const std::string& path);
+
+}
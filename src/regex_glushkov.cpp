@@ -0,0 +1,265 @@
+/**
+ * @file	regex_glushkov.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/15
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "regex_charset.hpp"
+#include "regex_constants.hpp"
+#include "regex_glushkov.hpp"
+#include "regex_options.hpp"
+#include "regex_postfix.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Types -- */
+
+namespace
+{
+
+  /** Struct describing a subexpression of a Glushkov automaton under construction. */
+  struct glushkov_info
+  {
+
+    /** The index of the first position belonging to the subexpression. */
+    size_t begin;
+
+    /** The positions which can start a match of the subexpression. */
+    vector<size_t> first;
+
+    /** The positions which can end a match of the subexpression. */
+    vector<size_t> last;
+
+    /** `true` if the subexpression matches the empty string. */
+    bool nullable;
+
+  };
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns the union of two sorted position lists. */
+  vector<size_t> merge(const vector<size_t>& set1, const vector<size_t>& set2)
+  {
+    vector<size_t> result;
+    result.reserve(set1.size() + set2.size());
+    set_union(set1.begin(), set1.end(), set2.begin(), set2.end(), back_inserter(result));
+    return result;
+  }
+
+}
+
+/* -- Procedures -- */
+
+regex_glushkov lexer::postfix_to_glushkov(const string& postfix, const regex_options& options)
+{
+  vector<regex_charset> positions;
+  vector<vector<size_t>> follow;
+  vector<glushkov_info> stack;
+
+  // local procedure to pop an operand off of the stack
+  auto pop_info = [&] () -> glushkov_info {
+    if (stack.empty())
+      throw runtime_error("Regular expression is invalid!");
+    auto info = stack.back();
+    stack.pop_back();
+    return info;
+  };
+
+  // local procedure to verify that we can create the specified number of new positions
+  auto reserve_positions = [&] (size_t count) {
+    if (count > options.max_fragments || positions.size() > options.max_fragments - count)
+      throw runtime_error("Regular expression is too large!");
+  };
+
+  // local procedure to add `targets` to the follow set of each position in `sources`
+  auto add_follow = [&] (const vector<size_t>& sources, const vector<size_t>& targets) {
+    for (auto pos : sources)
+      follow[pos] = merge(follow[pos], targets);
+  };
+
+  // local procedure to copy the positions of the topmost operand
+  // - since operands are built one after the other, the operand's positions are the ones from
+  //   `e.begin` to the end, and none of them can be followed by a position outside of that range
+  auto copy_info = [&] (const glushkov_info& e, size_t end) -> glushkov_info {
+    auto offset = positions.size() - e.begin;
+    auto shift = [&] (const vector<size_t>& set) {
+      vector<size_t> result;
+      for (auto pos : set)
+        result.push_back(pos + offset);
+      return result;
+    };
+    for (auto pos = e.begin; pos < end; pos++)
+    {
+      auto set = positions[pos];
+      positions.push_back(set);
+      follow.push_back(shift(follow[pos]));
+    }
+    return { e.begin + offset, shift(e.first), shift(e.last), e.nullable };
+  };
+
+  // local procedures implementing each operator
+  auto concat = [&] (const glushkov_info& e1, const glushkov_info& e2) -> glushkov_info {
+    add_follow(e1.last, e2.first);
+    return {
+      e1.begin,
+      (e1.nullable ? merge(e1.first, e2.first) : e1.first),
+      (e2.nullable ? merge(e1.last, e2.last) : e2.last),
+      e1.nullable && e2.nullable
+    };
+  };
+  auto optional = [&] (glushkov_info e) -> glushkov_info {
+    e.nullable = true;
+    return e;
+  };
+  auto repeat = [&] (const glushkov_info& e) -> glushkov_info {
+    add_follow(e.last, e.first);
+    return e;
+  };
+  auto kleene = [&] (const glushkov_info& e) -> glushkov_info {
+    return optional(repeat(e));
+  };
+
+  for (size_t idx = 0; idx < postfix.size(); idx++)
+  {
+    switch (postfix[idx])
+    {
+
+    case regex_constants::concat_op:
+    {
+      auto e2 = pop_info();
+      auto e1 = pop_info();
+      stack.push_back(concat(e1, e2));
+      break;
+    }
+
+    case regex_constants::union_op:
+    {
+      auto e2 = pop_info();
+      auto e1 = pop_info();
+      stack.push_back({
+          e1.begin,
+          merge(e1.first, e2.first),
+          merge(e1.last, e2.last),
+          e1.nullable || e2.nullable
+        });
+      break;
+    }
+
+    case regex_constants::optional_op:
+      stack.push_back(optional(pop_info()));
+      break;
+
+    case regex_constants::kleene_op:
+      stack.push_back(kleene(pop_info()));
+      break;
+
+    case regex_constants::repeat_op:
+      stack.push_back(repeat(pop_info()));
+      break;
+
+    case regex_constants::open_repetition_op:
+    {
+      // same expansion as `lexer::regex_to_nfa`: m copies of E followed by either E* or nested
+      // optional copies of E - all copies are made before any of them are linked together
+      auto repetition = parse_regex_repetition(postfix, idx);
+      idx += repetition.length - 1;
+
+      auto e = pop_info();
+      auto end = positions.size();
+      auto bounded = (repetition.max != regex_repetition::unbounded);
+      auto copies = (bounded ? repetition.max : max<size_t>(repetition.min, 1));
+      if (copies == 0)
+      {
+        // E{0} matches only the empty string, so its positions can be discarded
+        positions.resize(e.begin);
+        follow.resize(e.begin);
+        stack.push_back({ e.begin, { }, { }, true });
+        break;
+      }
+
+      auto size = end - e.begin;
+      if (size > 0 && size > options.max_fragments / copies)
+        throw runtime_error("Regular expression is too large!");
+      reserve_positions(size * (copies - 1));
+
+      vector<glushkov_info> infos { e };
+      while (infos.size() < copies)
+        infos.push_back(copy_info(e, end));
+
+      glushkov_info result { e.begin, { }, { }, true };
+      for (size_t count = 0; count + 1 < repetition.min; count++)
+        result = concat(result, infos[count]);
+
+      if (!bounded)
+      {
+        auto last = infos[copies - 1];
+        result = concat(result, (repetition.min == 0 ? kleene(last) : repeat(last)));
+      }
+      else
+      {
+        if (repetition.min > 0)
+          result = concat(result, infos[repetition.min - 1]);
+
+        bool has_tail = false;
+        glushkov_info tail;
+        for (auto count = repetition.max; count-- > repetition.min; )
+        {
+          tail = optional(has_tail ? concat(infos[count], tail) : infos[count]);
+          has_tail = true;
+        }
+        if (has_tail)
+          result = concat(result, tail);
+      }
+
+      stack.push_back(result);
+      break;
+    }
+
+    default:
+    {
+      reserve_positions(1);
+      size_t length = 0;
+      auto set = regex_atom_charset(postfix, idx, length);
+      idx += length - 1;
+
+      auto pos = positions.size();
+      positions.push_back(set);
+      follow.emplace_back();
+      stack.push_back({ pos, { pos }, { pos }, false });
+      break;
+    }
+
+    }
+  }
+
+  if (stack.size() != 1)
+    throw runtime_error("Regular expression is invalid!");
+
+  auto& info = stack.back();
+  return regex_glushkov(move(positions),
+                        move(info.first),
+                        move(info.last),
+                        move(follow),
+                        info.nullable);
+}
+
+regex_glushkov lexer::regex_to_glushkov(const string& regex, const regex_options& options)
+{
+  return postfix_to_glushkov(regex_to_postfix(regex), options);
+}
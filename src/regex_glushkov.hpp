@@ -0,0 +1,129 @@
+/**
+ * @file	regex_glushkov.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/15
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "regex_charset.hpp"
+#include "regex_options.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing the Glushkov (position) automaton for a regular expression.
+   *
+   * Each position is one occurrence of an atom in the (repetition-expanded) regular expression,
+   * and is entered by reading a byte in that atom's set. Unlike the Thompson NFA built by
+   * `lexer::regex_to_nfa`, there are no epsilon transitions: a match starts in one of the `first`
+   * positions, moves from each position to one of its `follow` positions, and ends in one of the
+   * `last` positions (or matches the empty string, if the expression is `nullable`).
+   *
+   * All position lists are sorted and contain no duplicates.
+   */
+  class regex_glushkov
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_glushkov` instance. */
+    regex_glushkov(std::vector<lexer::regex_charset> positions,
+                   std::vector<std::size_t> first,
+                   std::vector<std::size_t> last,
+                   std::vector<std::vector<std::size_t>> follow,
+                   bool nullable)
+      : m_positions(std::move(positions)),
+        m_first(std::move(first)),
+        m_last(std::move(last)),
+        m_follow(std::move(follow)),
+        m_nullable(nullable)
+    { }
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the number of positions. */
+    std::size_t size() const
+    {
+      return m_positions.size();
+    }
+
+    /** Returns the set of bytes accepted by each position. */
+    const std::vector<lexer::regex_charset>& positions() const
+    {
+      return m_positions;
+    }
+
+    /** Returns the positions which can start a match. */
+    const std::vector<std::size_t>& first() const
+    {
+      return m_first;
+    }
+
+    /** Returns the positions which can end a match. */
+    const std::vector<std::size_t>& last() const
+    {
+      return m_last;
+    }
+
+    /** Returns the positions which can follow each position. */
+    const std::vector<std::vector<std::size_t>>& follow() const
+    {
+      return m_follow;
+    }
+
+    /** Returns `true` if the regular expression matches the empty string. */
+    bool nullable() const
+    {
+      return m_nullable;
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    std::vector<lexer::regex_charset> m_positions;
+    std::vector<std::size_t> m_first;
+    std::vector<std::size_t> m_last;
+    std::vector<std::vector<std::size_t>> m_follow;
+    bool m_nullable;
+
+  };
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Convert a regular expression in postfix notation to a Glushkov automaton.
+   *
+   * @note
+   * `options.max_fragments` limits the number of positions.
+   */
+  lexer::regex_glushkov postfix_to_glushkov(const std::string& postfix,
+                                            const lexer::regex_options& options = lexer::regex_options());
+
+  /**
+   * Convert a regular expression to a Glushkov automaton.
+   */
+  lexer::regex_glushkov regex_to_glushkov(const std::string& regex,
+                                          const lexer::regex_options& options = lexer::regex_options());
+
+}
@@ -6,17 +6,23 @@
 
 /* -- Includes -- */
 
-#include <cassert>
+#include <algorithm>
 #include <limits>
-#include <list>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "regex_cache.hpp"
+#include "regex_charset.hpp"
 #include "regex_constants.hpp"
 #include "regex_nfa.hpp"
+#include "regex_nfa_builder.hpp"
+#include "regex_options.hpp"
+#include "regex_parser.hpp"
 #include "regex_postfix.hpp"
+#include "regex_sparse_set.hpp"
 
 /* -- Namespaces -- */
 
@@ -27,190 +33,77 @@ using namespace lexer;
 
 const regex_nfa_fragment::symbol_type regex_nfa_fragment::invalid_symbol = std::numeric_limits<symbol_type>::max();
 const regex_nfa_fragment::symbol_type regex_nfa_fragment::epsilon_symbol = std::numeric_limits<symbol_type>::max() - 1;
-
-/* -- Private Procedures -- */
-
-namespace
-{
-
-  /**
-   * Recursively sets the output of a `lexer::regex_nfa_fragment` tree.
-   *
-   * @note
-   * The `prev` parameter is to prevent infinitely recursing in case of loops. Since all loops in
-   * the regular expression NFA construction only point to the "previous" node, we only need to
-   * check one level backwards to ensure that we don't loop around.
-   */
-  void set_output(regex_nfa_fragment* nfa, regex_nfa_fragment* output, const regex_nfa_fragment* prev)
-  {
-    // first link
-    if (nfa->link1.is_valid())
-    {
-      if (nfa->link1.output && nfa->link1.output != prev)
-        set_output(nfa->link1.output, output, nfa);
-      else if (!nfa->link1.output)
-        nfa->link1.output = output;
-    }
-
-    // second link
-    if (nfa->link2.is_valid())
-    {
-      if (nfa->link2.output && nfa->link2.output != prev)
-        set_output(nfa->link2.output, output, nfa);
-      else if (!nfa->link2.output)
-        nfa->link2.output = output;
-    }
-
-    // sanity check
-    assert(nfa->link1.output != nfa);
-    assert(nfa->link2.output != nfa);
-  }
-
-  /** Sets the output of a `lexer::regex_nfa_fragment` tree. */
-  void set_output(regex_nfa_fragment* nfa, regex_nfa_fragment* output)
-  {
-    set_output(nfa, output, nullptr);
-  }
-
-}
+const regex_nfa_fragment::symbol_type regex_nfa_fragment::set_symbol = std::numeric_limits<symbol_type>::max() - 2;
+const size_t regex_nfa_fragment::no_slot = std::numeric_limits<size_t>::max();
 
 /* -- Procedures -- */
 
-regex_nfa lexer::regex_to_nfa(const string& regex)
+regex_nfa lexer::postfix_to_nfa(const string& postfix, const regex_options& options)
 {
-  // convert regex to postfix notation
-  string postfix = regex_to_postfix(regex);
-
-  // container for pointers to all of the fragments we need to allocate
-  vector<unique_ptr<regex_nfa_fragment>> fragments;
-
-  // processing stack
-  vector<regex_nfa_fragment*> stack;
-
-  // local procedures to create and return new framgnets
-  auto new_terminal_fragment = [&] () -> regex_nfa_fragment* {
-    fragments.push_back(regex_nfa_fragment::create_terminal());
-    return fragments.back().get();
-  };
-  auto new_epsilon_fragment = [&] () -> regex_nfa_fragment* {
-    fragments.push_back(regex_nfa_fragment::create_epsilon());
-    return fragments.back().get();
-  };
-  auto new_symbol_fragment = [&] (regex_nfa_fragment::symbol_type symbol) -> regex_nfa_fragment* {
-    fragments.push_back(regex_nfa_fragment::create_symbol(symbol));
-    return fragments.back().get();
-  };
-
-  // local procedure to push a fragment onto the stack
-  auto push_fragment = [&] (regex_nfa_fragment* frag) {
-    stack.push_back(frag);
-  };
-
-  // local procedure to pop a fragment off of the stack
-  auto pop_fragment = [&] () -> regex_nfa_fragment* {
-    auto* frag = stack.back();
+  // processing stack - since operands are always built one after the other, the fragments for
+  // each entry on the stack are contiguous, as `regex_nfa_builder::repetition` requires
+  regex_nfa_builder builder(options);
+  vector<regex_nfa_builder::part> stack;
+
+  // local procedure to pop a part off of the stack
+  auto pop_part = [&] () -> regex_nfa_builder::part {
+    if (stack.empty())
+      throw runtime_error("Regular expression is invalid!");
+    auto e = stack.back();
     stack.pop_back();
-    return frag;
+    return e;
   };
 
   // loop through each character in regular expression
   // this is largely based on https://swtch.com/~rsc/regexp/regexp1.html
-  for (const auto& ch : postfix)
+  for (size_t idx = 0; idx < postfix.size(); idx++)
   {
+    char ch = postfix[idx];
     switch (ch)
     {
 
     case regex_constants::concat_op:
     {
-      // - E1 and E2 are popped off stack
-      // - all links are epsilon links
-      //
-      //    IN -> E1 -> E2 -> OUT
-      //
-      auto e2 = pop_fragment();
-      auto e1 = pop_fragment();
-      set_output(e1, e2);
-      push_fragment(e1);
+      auto e2 = pop_part();
+      auto e1 = pop_part();
+      stack.push_back(builder.concat(e1, e2));
       break;
     }
 
     case regex_constants::union_op:
     {
-      // - E1 and E2 are popped off stack
-      // - all links are epsilon links
-      //
-      //    IN -> NFA -> E1 -> OUT
-      //           |
-      //           +---> E2 -> OUT
-      //
-      auto nfa = new_epsilon_fragment();
-      nfa->link2.output = pop_fragment();
-      nfa->link1.output = pop_fragment();
-      push_fragment(nfa);
+      auto e2 = pop_part();
+      auto e1 = pop_part();
+      stack.push_back(builder.alternate(e1, e2));
       break;
     }
 
     case regex_constants::optional_op:
-    {
-      // - E is popped off stack
-      // - all links are epsilon links
-      //
-      //    IN -> NFA -> E -> OUT
-      //           |
-      //           +--------> OUT
-      //
-      auto nfa = new_epsilon_fragment();
-      nfa->link1.output = pop_fragment();
-      push_fragment(nfa);
+      stack.push_back(builder.optional(pop_part()));
       break;
-    }
 
     case regex_constants::kleene_op:
-    {
-      // - E is popped off stack
-      // - all links are epsilon links
-      //
-      //           +-----+
-      //           |     |
-      //           v     |
-      //    IN -> NFA -> E
-      //           |
-      //           +---> OUT
-      //
-      auto nfa = new_epsilon_fragment();
-      nfa->link1.output = pop_fragment();
-      set_output(nfa->link1.output, nfa);
-      push_fragment(nfa);
+      stack.push_back(builder.kleene(pop_part()));
       break;
-    }
 
     case regex_constants::repeat_op:
+      stack.push_back(builder.repeat(pop_part()));
+      break;
+
+    case regex_constants::open_repetition_op:
     {
-      // - E is popped off stack
-      // - all links are epsilon links
-      //
-      //          +-----+
-      //          |     |
-      //          v     |
-      //    IN -> E -> NFA -> OUT
-      //
-      auto nfa = new_epsilon_fragment();
-      auto e = pop_fragment();
-      set_output(e, nfa);
-      nfa->link1.output = e;
-      push_fragment(e);
+      auto repetition = parse_regex_repetition(postfix, idx);
+      idx += repetition.length - 1;
+      stack.push_back(builder.repetition(pop_part(), repetition));
       break;
     }
 
     default:
     {
-      // - link requires a matching symbol
-      //
-      //       ch
-      //    IN -> OUT
-      //
-      auto nfa = new_symbol_fragment(ch);
-      push_fragment(nfa);
+      size_t length = 0;
+      auto set = regex_atom_charset(postfix, idx, length);
+      idx += length - 1;
+      stack.push_back(builder.atom(set));
       break;
     }
 
@@ -222,89 +115,156 @@ regex_nfa lexer::regex_to_nfa(const string& regex)
     throw runtime_error("Regular expression is invalid!");
 
   // add terminal node to complete the NFA
-  auto head = stack.back();
-  auto terminal = new_terminal_fragment();
-  set_output(head, terminal);
+  return builder.finish(stack.back());
+}
 
-  // return the final object
-  return regex_nfa(move(fragments), head);
+regex_nfa lexer::regex_to_nfa(const string& regex, const regex_options& options)
+{
+  return parse_regex(regex, options);
 }
 
-bool lexer::regex_match(const string& regex, const string& str)
+regex_nfa::regex_nfa(vector<unique_ptr<regex_nfa_fragment>> fragments, const regex_nfa_fragment* head)
+  : m_fragments(move(fragments)),
+    m_head(head),
+    m_slot_count(0)
 {
-  regex_nfa nfa = regex_to_nfa(regex);
+  for (size_t idx = 0; idx < m_fragments.size(); idx++)
+  {
+    m_fragments[idx]->index = idx;
+    if (m_fragments[idx]->is_save())
+      m_slot_count = max(m_slot_count, m_fragments[idx]->slot + 1);
+  }
+}
 
-  // we use a linked list to store searches because we'll be inserting and
-  // removing at arbitrary positions
-  list<const regex_nfa_fragment*> searches;
-  searches.push_back(nfa.head());
+regex_nfa lexer::reverse_nfa(const regex_nfa& nfa)
+{
+  const auto& fragments = nfa.fragments();
+  vector<unique_ptr<regex_nfa_fragment>> reversed;
 
-  for (auto ch : str)
+  // local procedure to add a fragment to the reversed NFA
+  auto add = [&] (unique_ptr<regex_nfa_fragment> frag) {
+    reversed.push_back(move(frag));
+    return reversed.back().get();
+  };
+
+  // every link of the original NFA becomes a fragment with the reversed link, whose output is
+  // connected below - `sources[n]` is the original fragment the link came from, and `incoming[n]`
+  // lists the reversed links for the links leading into fragment `n`
+  vector<regex_nfa_fragment*> links;
+  vector<size_t> sources;
+  vector<vector<regex_nfa_fragment*>> incoming(fragments.size());
+  auto add_link = [&] (unique_ptr<regex_nfa_fragment> link,
+                       const regex_nfa_fragment* source,
+                       const regex_nfa_fragment* output) {
+    links.push_back(add(move(link)));
+    sources.push_back(source->index);
+    incoming[output->index].push_back(links.back());
+  };
+
+  const regex_nfa_fragment* terminal = nullptr;
+  for (const auto& frag : fragments)
   {
-    auto search_it = searches.begin();
-    while (search_it != searches.end())
+    if (frag->is_terminal())
+      terminal = frag.get();
+    else if (frag->is_symbol())
     {
-      // get fragment at this position
-      auto frag = *search_it;
-
-      // advance fragment through any epsilons, spinning off new searches as needed
-      while (frag->is_epsilon())
-      {
-        searches.push_back(frag->link2.output);
-        frag = frag->link1.output;
-      }
-
-      // if the search reaches a terminal node, search was successful so return true
-      if (frag->is_terminal())
-        return true;
-
-      // we should now be at a symbol node
-      assert(frag->is_symbol());
+      add_link(frag->link1.symbol == regex_nfa_fragment::set_symbol ?
+               regex_nfa_fragment::create_set(*frag->link1.set) :
+               regex_nfa_fragment::create_symbol(frag->link1.symbol),
+               frag.get(),
+               frag->link1.output);
+    }
+    else
+    {
+      add_link(regex_nfa_fragment::create_epsilon(), frag.get(), frag->link1.output);
+      if (frag->link2.output != frag->link1.output)
+        add_link(regex_nfa_fragment::create_epsilon(), frag.get(), frag->link2.output);
+    }
+  }
 
-      // if the symbol matches, we can continue, so advance
-      if (frag->link1.symbol == ch)
-      {
-        frag = frag->link1.output;
+  // reaching the original head means the whole string has been matched
+  incoming[nfa.head()->index].push_back(add(regex_nfa_fragment::create_terminal()));
 
-        // if the result is a terminal node, search was successful so return true
-        if (frag->is_terminal())
-          return true;
+  // each original fragment becomes the entry to its incoming links - a chain of epsilon fragments
+  // if there is more than one, or a fragment matching nothing if there are none
+  vector<regex_nfa_fragment*> entries(fragments.size());
+  for (size_t idx = 0; idx < fragments.size(); idx++)
+  {
+    const auto& targets = incoming[idx];
+    if (targets.empty())
+    {
+      auto dead = add(regex_nfa_fragment::create_set(regex_charset()));
+      dead->link1.output = dead;
+      entries[idx] = dead;
+      continue;
+    }
 
-        // otherwise, write back the updated fragment, and move on to next search
-        else
-        {
-          *search_it = frag;
-          search_it++;
-        }
-      }
-
-      // symbol doesn't match. this search is a dead end, so drop it and move on to the next one
-      else
-      {
-        auto temp = search_it;
-        search_it++;
-        searches.erase(temp);
-      }
+    auto entry = targets.back();
+    for (auto target = targets.size() - 1; target-- > 0; )
+    {
+      auto fork = add(regex_nfa_fragment::create_epsilon());
+      fork->link1.output = targets[target];
+      fork->link2.output = entry;
+      entry = fork;
     }
+    entries[idx] = entry;
+  }
 
-    // if all searches are gone, it's not a match
-    if (searches.empty())
-      return false;
+  for (size_t link = 0; link < links.size(); link++)
+  {
+    links[link]->link1.output = entries[sources[link]];
+    if (links[link]->is_epsilon())
+      links[link]->link2.output = entries[sources[link]];
   }
 
-  // out of input - check if any live searches have a clear path to a terminal node
-  auto search_it = searches.begin();
-  while (search_it != searches.end())
+  return regex_nfa(move(reversed), entries[terminal->index]);
+}
+
+bool lexer::regex_match(const string& regex, const string& str)
+{
+  return regex_match(*regex_cache::global().get(regex), str);
+}
+
+bool lexer::regex_match(const regex_nfa& nfa, const string& str)
+{
+  const auto& fragments = nfa.fragments();
+
+  // the fragments which the simulation is currently in - these are always symbol or terminal
+  // fragments, since we only ever enter fragments through their closures
+  regex_sparse_set current(fragments.size());
+  regex_sparse_set next(fragments.size());
+  regex_nfa_closure closure(nfa);
+
+  // local procedure to enter a fragment, returning `true` if this reaches a terminal fragment
+  bool matched = false;
+  auto enter = [&] (regex_sparse_set& set, const regex_nfa_fragment* frag) {
+    closure.add(frag, [&] (size_t index) {
+        if (fragments[index]->is_terminal())
+          matched = true;
+        else
+          set.insert(index);
+      });
+    return matched;
+  };
+
+  if (enter(current, nfa.head()))
+    return true;
+
+  for (auto ch : str)
   {
-    auto frag = *search_it;
-    while (frag->is_epsilon())
+    next.clear();
+    closure.clear();
+    for (auto index : current)
     {
-      searches.push_back(frag->link2.output);
-      frag = frag->link1.output;
+      const auto* frag = fragments[index].get();
+      if (frag->link1.matches(static_cast<unsigned char>(ch)) && enter(next, frag->link1.output))
+        return true;
     }
-    if (frag->is_terminal())
-      return true;
-    search_it++;
+
+    // if all searches are gone, it's not a match
+    if (next.empty())
+      return false;
+    swap(current, next);
   }
 
   // we ran out of input before reaching a terminal
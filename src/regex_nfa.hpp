@@ -4,13 +4,20 @@
  * @date	2017/01/24
  */
 
+#pragma once
+
 /* -- Includes -- */
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "regex_charset.hpp"
+#include "regex_options.hpp"
+#include "regex_sparse_set.hpp"
+
 /* -- Types -- */
 
 namespace lexer
@@ -39,6 +46,12 @@ namespace lexer
     /** Constant representing an epsilon link. */
     static const symbol_type epsilon_symbol;
 
+    /** Constant representing a link matching any byte in a `lexer::regex_charset`. */
+    static const symbol_type set_symbol;
+
+    /** Constant representing a fragment which does not record a capture position. */
+    static const std::size_t no_slot;
+
     /* -- Embedded Types -- */
 
   private:
@@ -52,6 +65,7 @@ namespace lexer
       /** Constructs a new `lexer::regex_nfa_fragment::link` instance. */
       link(symbol_type symbol)
         : symbol(symbol),
+          set(),
           output(nullptr)
       { }
 
@@ -60,6 +74,9 @@ namespace lexer
       /** The symbol type for this link. */
       const symbol_type symbol;
 
+      /** The set of bytes matched by this link, if `symbol` is `set_symbol`. */
+      std::shared_ptr<const lexer::regex_charset> set;
+
       /** The NFA that this link is connected to. */
       regex_nfa_fragment* output;
 
@@ -77,6 +94,22 @@ namespace lexer
         return (symbol == epsilon_symbol);
       }
 
+      /** Returns `true` if this is a symbol link matching the specified byte. */
+      bool matches(unsigned char ch) const
+      {
+        return (symbol == set_symbol ? set->test(ch) : symbol == ch);
+      }
+
+      /** Returns the set of bytes matched by this symbol link. */
+      lexer::regex_charset charset() const
+      {
+        if (symbol == set_symbol)
+          return *set;
+        lexer::regex_charset result;
+        result.set(static_cast<unsigned char>(symbol));
+        return result;
+      }
+
     };
 
     /* -- Lifecycle -- */
@@ -99,6 +132,19 @@ namespace lexer
                                       lexer::regex_nfa_fragment::invalid_symbol));
     }
 
+    /**
+     * Creates a new epsilon fragment which records the current position in capture slot `slot`.
+     *
+     * Both links lead to the same place, so the fragment behaves exactly like any other epsilon
+     * fragment except when matching with captures (see `regex_pike_vm.hpp`).
+     */
+    static auto create_save(std::size_t slot)
+    {
+      auto frag = create_epsilon();
+      frag->slot = slot;
+      return frag;
+    }
+
     /** Creates a new symbol ("normal") fragment. */
     static auto create_symbol(symbol_type symbol)
     {
@@ -107,12 +153,35 @@ namespace lexer
                                       lexer::regex_nfa_fragment::invalid_symbol));
     }
 
+    /** Creates a new symbol fragment matching any byte in the specified set. */
+    static auto create_set(lexer::regex_charset set)
+    {
+      auto frag = std::unique_ptr<lexer::regex_nfa_fragment>(
+        new lexer::regex_nfa_fragment(lexer::regex_nfa_fragment::set_symbol,
+                                      lexer::regex_nfa_fragment::invalid_symbol));
+      frag->link1.set = std::make_shared<const lexer::regex_charset>(set);
+      return frag;
+    }
+
+    /** Creates a new unlinked fragment with the same symbols as an existing fragment. */
+    static auto create_copy(const lexer::regex_nfa_fragment& other)
+    {
+      auto frag = std::unique_ptr<lexer::regex_nfa_fragment>(
+        new lexer::regex_nfa_fragment(other.link1.symbol, other.link2.symbol));
+      frag->link1.set = other.link1.set;
+      frag->link2.set = other.link2.set;
+      frag->slot = other.slot;
+      return frag;
+    }
+
   private:
 
     /** Constructs a `lexer::regex_nfa_fragment` with two valid output links. */
     regex_nfa_fragment(symbol_type symbol1, symbol_type symbol2)
       : link1(symbol1),
-        link2(symbol2)
+        link2(symbol2),
+        index(0),
+        slot(no_slot)
     { }
 
     /* -- Fields -- */
@@ -125,6 +194,12 @@ namespace lexer
     /** The second link for this NFA. */
     link link2;
 
+    /** The index of this fragment within the `lexer::regex_nfa` which owns it. */
+    std::size_t index;
+
+    /** The capture slot this fragment records the position in, or `no_slot`. */
+    std::size_t slot;
+
     /* -- Public Methods -- */
 
   public:
@@ -135,6 +210,12 @@ namespace lexer
       return (link1.is_epsilon() && link2.is_epsilon());
     }
 
+    /** Returns `true` if this is an epsilon node which records a capture position. */
+    bool is_save() const
+    {
+      return (slot != no_slot);
+    }
+
     /** Returns `true` if this is a terminal node. */
     bool is_terminal() const
     {
@@ -159,11 +240,15 @@ namespace lexer
 
   public:
 
-    /** Constructs a new `lexer::regex_nfa` instance. */
-    regex_nfa(std::vector<std::unique_ptr<regex_nfa_fragment>> fragments, const regex_nfa_fragment* head)
-      : m_fragments(std::move(fragments)),
-        m_head(head)
-    { }
+    /**
+     * Constructs a new `lexer::regex_nfa` instance.
+     *
+     * @note
+     * This numbers the fragments, which takes time in proportion to the number of fragments.
+     * Epsilon closures are not stored, but computed by simulations as they need them (see
+     * `lexer::regex_nfa_closure`).
+     */
+    regex_nfa(std::vector<std::unique_ptr<regex_nfa_fragment>> fragments, const regex_nfa_fragment* head);
 
     /* -- Public Methods -- */
 
@@ -175,12 +260,98 @@ namespace lexer
       return m_head;
     }
 
+    /** Returns all of the fragments owned by this NFA, ordered by index. */
+    const std::vector<std::unique_ptr<regex_nfa_fragment>>& fragments() const
+    {
+      return m_fragments;
+    }
+
+    /**
+     * Returns the number of capture slots recorded by this NFA's save fragments.
+     *
+     * This is zero unless the NFA was built with `lexer::regex_options::captures` set, in which
+     * case there are two slots (start and end) for the whole match and for each group.
+     */
+    std::size_t slot_count() const
+    {
+      return m_slot_count;
+    }
+
     /* -- Implementation -- */
 
   private:
 
     std::vector<std::unique_ptr<regex_nfa_fragment>> m_fragments;
     const regex_nfa_fragment* m_head;
+    std::size_t m_slot_count;
+
+  };
+
+  /**
+   * Class which computes epsilon closures in a `lexer::regex_nfa`, i.e. the symbol and terminal
+   * fragments a simulation is in after entering a fragment.
+   *
+   * Every fragment reached (including epsilon fragments) is remembered until `clear` is called,
+   * so the closure of a whole set of fragments - e.g. everything entered on one input byte - visits
+   * each fragment at most once, however much the closures of the individual fragments overlap.
+   * Simulations therefore cost time in proportion to the fragments they reach, and nothing is
+   * computed or stored in advance.
+   */
+  class regex_nfa_closure
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_nfa_closure` for the specified NFA. */
+    explicit regex_nfa_closure(const lexer::regex_nfa& nfa)
+      : m_visited(nfa.fragments().size()),
+        m_stack()
+    { }
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Forgets every fragment reached so far, to start computing a new closure. */
+    void clear()
+    {
+      m_visited.clear();
+    }
+
+    /**
+     * Calls `visit` with the index of each symbol and terminal fragment which can be reached from
+     * `entry` by following only epsilon links, in priority order (`link1` first). Fragments which
+     * have already been reached since the last call to `clear` are skipped.
+     */
+    template <typename visit_fn>
+    void add(const lexer::regex_nfa_fragment* entry, visit_fn visit)
+    {
+      m_stack.push_back(entry);
+      while (!m_stack.empty())
+      {
+        auto frag = m_stack.back();
+        m_stack.pop_back();
+        if (!m_visited.insert(frag->index))
+          continue;
+
+        if (frag->is_epsilon())
+        {
+          m_stack.push_back(frag->link2.output);
+          m_stack.push_back(frag->link1.output);
+        }
+        else
+          visit(frag->index);
+      }
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    lexer::regex_sparse_set m_visited;
+    std::vector<const lexer::regex_nfa_fragment*> m_stack;
 
   };
 
@@ -191,14 +362,38 @@ namespace lexer
 namespace lexer
 {
 
+  /**
+   * Convert a regular expression in postfix notation to an NFA.
+   */
+  lexer::regex_nfa postfix_to_nfa(const std::string& postfix,
+                                  const lexer::regex_options& options = lexer::regex_options());
+
   /**
    * Convert a regular expression to an NFA.
    */
-  lexer::regex_nfa regex_to_nfa(const std::string& regex);
+  lexer::regex_nfa regex_to_nfa(const std::string& regex,
+                                const lexer::regex_options& options = lexer::regex_options());
+
+  /**
+   * Returns the reverse of an NFA, which matches the reverse of every string the NFA matches.
+   *
+   * Every link is reversed, and the head and terminal fragments swap roles. Since a fragment may
+   * have any number of incoming links, each fragment becomes a chain of epsilon fragments leading
+   * to the reversed links. Capture slots are dropped.
+   */
+  lexer::regex_nfa reverse_nfa(const lexer::regex_nfa& nfa);
 
   /**
    * Check if a string matches a regular expression.
+   *
+   * The regular expression's NFA is looked up in `lexer::regex_cache::global()`, so it is only
+   * compiled if it has not been used recently.
    */
   bool regex_match(const std::string& regex, const std::string& str);
 
+  /**
+   * Check if a string matches an NFA.
+   */
+  bool regex_match(const lexer::regex_nfa& nfa, const std::string& str);
+
 }
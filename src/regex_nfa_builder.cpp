@@ -0,0 +1,332 @@
+/**
+ * @file	regex_nfa_builder.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/16
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "regex_charset.hpp"
+#include "regex_nfa.hpp"
+#include "regex_nfa_builder.hpp"
+#include "regex_options.hpp"
+#include "regex_postfix.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Constants -- */
+
+const size_t regex_nfa_builder::npos = static_cast<size_t>(-1);
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  // links are numbered 2 * fragment index + 0 for link1, or + 1 for link2
+
+  /** Returns the number of the first link of the specified fragment. */
+  size_t link1_number(const regex_nfa_fragment* frag)
+  {
+    return (frag->index * 2);
+  }
+
+  /** Returns the number of the second link of the specified fragment. */
+  size_t link2_number(const regex_nfa_fragment* frag)
+  {
+    return (frag->index * 2 + 1);
+  }
+
+}
+
+/* -- Procedures -- */
+
+regex_nfa_builder::regex_nfa_builder(const regex_options& options)
+  : m_fragments(),
+    m_next(),
+    m_options(options)
+{
+}
+
+regex_nfa_builder::part regex_nfa_builder::atom(const regex_charset& set)
+{
+  // - link requires a matching symbol (or any symbol in a set, for escapes and classes)
+  //
+  //       ch
+  //    IN -> OUT
+  //
+  auto first = m_fragments.size();
+
+  regex_nfa_fragment* nfa = nullptr;
+  if (set.count() == 1)
+  {
+    regex_nfa_fragment::symbol_type symbol = 0;
+    while (!set.test(symbol))
+      symbol++;
+    nfa = add_fragment(regex_nfa_fragment::create_symbol(symbol));
+  }
+  else
+    nfa = add_fragment(regex_nfa_fragment::create_set(set));
+
+  return { nfa, first, single(link1_number(nfa)) };
+}
+
+regex_nfa_builder::part regex_nfa_builder::empty()
+{
+  // - both links of an epsilon fragment lead to the same place
+  //
+  //    IN -> NFA -> OUT
+  //
+  auto first = m_fragments.size();
+  auto nfa = add_fragment(regex_nfa_fragment::create_epsilon());
+  return { nfa, first, join(single(link1_number(nfa)), single(link2_number(nfa))) };
+}
+
+regex_nfa_builder::part regex_nfa_builder::concat(part e1, part e2)
+{
+  // - all links are epsilon links
+  //
+  //    IN -> E1 -> E2 -> OUT
+  //
+  patch(e1.outs, e2.head);
+  return { e1.head, min(e1.first, e2.first), e2.outs };
+}
+
+regex_nfa_builder::part regex_nfa_builder::alternate(part e1, part e2)
+{
+  // - all links are epsilon links
+  //
+  //    IN -> NFA -> E1 -> OUT
+  //           |
+  //           +---> E2 -> OUT
+  //
+  auto nfa = add_fragment(regex_nfa_fragment::create_epsilon());
+  nfa->link2.output = e2.head;
+  nfa->link1.output = e1.head;
+  return { nfa, min(e1.first, e2.first), join(e1.outs, e2.outs) };
+}
+
+regex_nfa_builder::part regex_nfa_builder::optional(part e)
+{
+  // - all links are epsilon links
+  //
+  //    IN -> NFA -> E -> OUT
+  //           |
+  //           +--------> OUT
+  //
+  auto nfa = add_fragment(regex_nfa_fragment::create_epsilon());
+  nfa->link1.output = e.head;
+  return { nfa, e.first, join(e.outs, single(link2_number(nfa))) };
+}
+
+regex_nfa_builder::part regex_nfa_builder::kleene(part e)
+{
+  // - all links are epsilon links
+  //
+  //           +-----+
+  //           |     |
+  //           v     |
+  //    IN -> NFA -> E
+  //           |
+  //           +---> OUT
+  //
+  auto nfa = add_fragment(regex_nfa_fragment::create_epsilon());
+  nfa->link1.output = e.head;
+  patch(e.outs, nfa);
+  return { nfa, e.first, single(link2_number(nfa)) };
+}
+
+regex_nfa_builder::part regex_nfa_builder::repeat(part e)
+{
+  // - all links are epsilon links
+  //
+  //          +-----+
+  //          |     |
+  //          v     |
+  //    IN -> E -> NFA -> OUT
+  //
+  auto nfa = add_fragment(regex_nfa_fragment::create_epsilon());
+  patch(e.outs, nfa);
+  nfa->link1.output = e.head;
+  return { e.head, e.first, single(link2_number(nfa)) };
+}
+
+regex_nfa_builder::part regex_nfa_builder::repetition(part e, const regex_repetition& repetition)
+{
+  // - E{m} is m copies of E:
+  //
+  //    IN -> E -> E -> ... -> E -> OUT
+  //
+  // - E{m,} is m copies of E, where the last copy is repeated (or E* if m is zero):
+  //
+  //    IN -> E -> ... -> E+ -> OUT
+  //
+  // - E{m,n} is m copies of E, followed by n - m nested optional copies of E, all of which
+  //   share the same exit. This keeps the number of simultaneously active states linear in
+  //   n - m, as opposed to E?E?E?..., where every optional copy can be skipped independently:
+  //
+  //    IN -> E -> ... -> E -> NFA -> E -> NFA -> E -> ... -> OUT
+  //                            |           |                   ^
+  //                            +-----------+-------------------+
+  //
+  // - the operand itself is used as the first copy, and the required number of copies is
+  //   checked against the fragment limit before any copies are made
+  auto last = m_fragments.size();
+  auto bounded = (repetition.max != regex_repetition::unbounded);
+  auto copies = (bounded ? repetition.max : max<size_t>(repetition.min, 1));
+  if (copies > 1)
+  {
+    auto size = last - e.first;
+    if (size > m_options.max_fragments / copies)
+      throw runtime_error("Regular expression is too large!");
+    reserve_fragments(size * (copies - 1) + copies);
+  }
+
+  // build all of the copies we need
+  vector<part> parts { e };
+  while (parts.size() < copies)
+    parts.push_back(copy(e, last));
+
+  // required copies
+  bool has_result = false;
+  part result;
+  auto link = [&] (part next) {
+    result = (has_result ? concat(result, next) : next);
+    has_result = true;
+  };
+  for (size_t count = 0; count + 1 < repetition.min; count++)
+    link(parts[count]);
+
+  if (!bounded)
+  {
+    // last required copy is repeated
+    auto last = parts[copies - 1];
+    link(repetition.min == 0 ? kleene(last) : repeat(last));
+  }
+  else
+  {
+    if (repetition.min > 0)
+      link(parts[repetition.min - 1]);
+
+    // optional copies, built from the innermost outwards
+    bool has_tail = false;
+    part tail;
+    for (auto count = repetition.max; count-- > repetition.min; )
+    {
+      tail = optional(has_tail ? concat(parts[count], tail) : parts[count]);
+      has_tail = true;
+    }
+    if (has_tail)
+      link(tail);
+  }
+
+  // E{0} (or E{0,0}) matches only the empty string
+  if (!has_result)
+    link(empty());
+
+  result.first = e.first;
+  return result;
+}
+
+regex_nfa_builder::part regex_nfa_builder::capture(part e, size_t group)
+{
+  // - all links are epsilon links, and the group's slots are 2 * group and 2 * group + 1
+  //
+  //    IN -> OPEN -> E -> CLOSE -> OUT
+  //
+  // - both save fragments are added after the operand, so the part's fragments stay contiguous
+  auto open = add_fragment(regex_nfa_fragment::create_save(group * 2));
+  auto close = add_fragment(regex_nfa_fragment::create_save(group * 2 + 1));
+  open->link1.output = e.head;
+  open->link2.output = e.head;
+  patch(e.outs, close);
+  return { open, e.first, join(single(link1_number(close)), single(link2_number(close))) };
+}
+
+regex_nfa regex_nfa_builder::finish(part e)
+{
+  auto terminal = add_fragment(regex_nfa_fragment::create_terminal());
+  patch(e.outs, terminal);
+
+  m_next.clear();
+  return regex_nfa(move(m_fragments), e.head);
+}
+
+void regex_nfa_builder::reserve_fragments(size_t count) const
+{
+  if (count > m_options.max_fragments || m_fragments.size() > m_options.max_fragments - count)
+    throw runtime_error("Regular expression is too large!");
+}
+
+regex_nfa_fragment* regex_nfa_builder::add_fragment(unique_ptr<regex_nfa_fragment> frag)
+{
+  reserve_fragments(1);
+  frag->index = m_fragments.size();
+  m_fragments.push_back(move(frag));
+  m_next.resize(m_fragments.size() * 2, npos);
+  return m_fragments.back().get();
+}
+
+regex_nfa_builder::part regex_nfa_builder::copy(const part& e, size_t last)
+{
+  // copies the fragments of `e` (ending before `last`) - the copy shares the symbol sets of the
+  // original, and its unconnected links are the copies of the original's unconnected links
+  auto first = e.first;
+  auto offset = m_fragments.size() - first;
+  for (auto idx = first; idx < last; idx++)
+    add_fragment(regex_nfa_fragment::create_copy(*m_fragments[idx]));
+  for (auto idx = first; idx < last; idx++)
+  {
+    const auto& frag = *m_fragments[idx];
+    auto& copy = *m_fragments[idx + offset];
+    if (frag.link1.output)
+      copy.link1.output = m_fragments[frag.link1.output->index + offset].get();
+    if (frag.link2.output)
+      copy.link2.output = m_fragments[frag.link2.output->index + offset].get();
+  }
+
+  patch_list outs { npos, npos };
+  for (auto link = e.outs.first; link != npos; link = (link == e.outs.last ? npos : m_next[link]))
+    outs = join(outs, single(link + offset * 2));
+
+  return { m_fragments[e.head->index + offset].get(), first + offset, outs };
+}
+
+regex_nfa_builder::patch_list regex_nfa_builder::single(size_t link) const
+{
+  return { link, link };
+}
+
+regex_nfa_builder::patch_list regex_nfa_builder::join(patch_list list1, patch_list list2)
+{
+  if (list1.first == npos)
+    return list2;
+  if (list2.first == npos)
+    return list1;
+
+  m_next[list1.last] = list2.first;
+  return { list1.first, list2.last };
+}
+
+void regex_nfa_builder::patch(patch_list list, regex_nfa_fragment* output)
+{
+  for (auto link = list.first; link != npos; )
+  {
+    // read the next link first, since it may be the last one
+    auto next = (link == list.last ? npos : m_next[link]);
+    auto* frag = m_fragments[link / 2].get();
+    if (link % 2 == 0)
+      frag->link1.output = output;
+    else
+      frag->link2.output = output;
+    link = next;
+  }
+}
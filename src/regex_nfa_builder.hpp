@@ -0,0 +1,137 @@
+/**
+ * @file	regex_nfa_builder.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/16
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "regex_charset.hpp"
+#include "regex_nfa.hpp"
+#include "regex_options.hpp"
+#include "regex_postfix.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class which builds a `lexer::regex_nfa` from the bottom up, one operator at a time.
+   *
+   * Each subexpression is built as a `part`, which carries the list of its links which are not
+   * connected to anything yet. Applying an operator connects these links directly (this is the
+   * "dangling out list" technique from https://swtch.com/~rsc/regexp/regexp1.html), so building
+   * an NFA takes time proportional to its size, without walking any part of the graph again.
+   */
+  class regex_nfa_builder
+  {
+
+    /* -- Embedded Types -- */
+
+  public:
+
+    /** Struct representing a list of unconnected links. */
+    struct patch_list
+    {
+
+      /** The first link in the list, or `npos` if the list is empty. */
+      std::size_t first;
+
+      /** The last link in the list, or `npos` if the list is empty. */
+      std::size_t last;
+
+    };
+
+    /** Struct representing the part of the NFA built for one subexpression. */
+    struct part
+    {
+
+      /** The fragment where the subexpression starts. */
+      lexer::regex_nfa_fragment* head;
+
+      /** The index of the first fragment created for the subexpression. */
+      std::size_t first;
+
+      /** The links which must be connected to whatever follows the subexpression. */
+      patch_list outs;
+
+    };
+
+    /* -- Constants -- */
+
+  public:
+
+    /** Value marking the end of a `patch_list`. */
+    static const std::size_t npos;
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_nfa_builder` instance. */
+    regex_nfa_builder(const lexer::regex_options& options = lexer::regex_options());
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns a part matching any byte in the specified set. */
+    part atom(const lexer::regex_charset& set);
+
+    /** Returns a part matching only the empty string. */
+    part empty();
+
+    /** Returns a part matching `e1` followed by `e2`. */
+    part concat(part e1, part e2);
+
+    /** Returns a part matching either `e1` or `e2`. */
+    part alternate(part e1, part e2);
+
+    /** Returns a part matching `e` or the empty string. */
+    part optional(part e);
+
+    /** Returns a part matching zero or more repetitions of `e`. */
+    part kleene(part e);
+
+    /** Returns a part matching one or more repetitions of `e`. */
+    part repeat(part e);
+
+    /**
+     * Returns a part matching between `repetition.min` and `repetition.max` repetitions of `e`.
+     *
+     * @note
+     * `e` must be the most recently built part, since its fragments are copied.
+     */
+    part repetition(part e, const lexer::regex_repetition& repetition);
+
+    /** Returns a part matching `e`, recording its start and end in the slots for `group`. */
+    part capture(part e, std::size_t group);
+
+    /** Connects `e` to a terminal fragment and returns the finished NFA. */
+    lexer::regex_nfa finish(part e);
+
+    /* -- Implementation -- */
+
+  private:
+
+    std::vector<std::unique_ptr<lexer::regex_nfa_fragment>> m_fragments;
+    std::vector<std::size_t> m_next;
+    lexer::regex_options m_options;
+
+    void reserve_fragments(std::size_t count) const;
+    lexer::regex_nfa_fragment* add_fragment(std::unique_ptr<lexer::regex_nfa_fragment> frag);
+    part copy(const part& e, std::size_t last);
+    patch_list single(std::size_t link) const;
+    patch_list join(patch_list list1, patch_list list2);
+    void patch(patch_list list, lexer::regex_nfa_fragment* output);
+
+  };
+
+}
@@ -0,0 +1,203 @@
+/**
+ * @file	regex_one_pass.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/21
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "regex_dfa.hpp"
+#include "regex_nfa.hpp"
+#include "regex_one_pass.hpp"
+#include "regex_pike_vm.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Constants -- */
+
+const regex_one_pass::state_type regex_one_pass::no_state = numeric_limits<state_type>::max();
+const size_t regex_one_pass::no_actions = numeric_limits<size_t>::max();
+
+/* -- Procedures -- */
+
+regex_one_pass::regex_one_pass(size_t slot_count,
+                               vector<uint8_t> classes,
+                               size_t class_count,
+                               vector<state_type> transitions,
+                               vector<size_t> transition_actions,
+                               vector<size_t> accept_actions,
+                               vector<size_t> action_offsets,
+                               vector<size_t> actions)
+  : m_slot_count(slot_count),
+    m_classes(move(classes)),
+    m_class_count(class_count),
+    m_transitions(move(transitions)),
+    m_transition_actions(move(transition_actions)),
+    m_accept_actions(move(accept_actions)),
+    m_action_offsets(move(action_offsets)),
+    m_actions(move(actions))
+{
+}
+
+bool regex_one_pass::match(const char* begin, const char* end, vector<regex_submatch>& submatches) const
+{
+  // since there is only ever one thread, its slots can be updated in place - the slots at the
+  // time of the last accepting state reached are copied out
+  vector<size_t> slots(m_slot_count, regex_submatch::npos);
+  vector<size_t> accepted;
+  bool matched = false;
+  auto apply = [&] (vector<size_t>& target, size_t list, size_t pos) {
+    for (auto idx = m_action_offsets[list]; idx < m_action_offsets[list + 1]; idx++)
+      target[m_actions[idx]] = pos;
+  };
+
+  const auto length = static_cast<size_t>(end - begin);
+  state_type state = 0;
+  for (size_t pos = 0; ; pos++)
+  {
+    if (m_accept_actions[state] != no_actions)
+    {
+      matched = true;
+      accepted = slots;
+      apply(accepted, m_accept_actions[state], pos);
+    }
+    if (pos == length)
+      break;
+
+    auto transition = state * m_class_count + m_classes[static_cast<unsigned char>(begin[pos])];
+    if (m_transitions[transition] == no_state)
+      break;
+    apply(slots, m_transition_actions[transition], pos);
+    state = m_transitions[transition];
+  }
+
+  submatches.assign(m_slot_count / 2, { regex_submatch::npos, regex_submatch::npos });
+  if (!matched)
+    return false;
+  for (size_t group = 0; group < submatches.size(); group++)
+  {
+    if (accepted[group * 2] != regex_submatch::npos && accepted[group * 2 + 1] != regex_submatch::npos)
+      submatches[group] = { accepted[group * 2], accepted[group * 2 + 1] };
+  }
+  return true;
+}
+
+bool regex_one_pass::match(const string& str, vector<regex_submatch>& submatches) const
+{
+  return match(str.data(), str.data() + str.size(), submatches);
+}
+
+unique_ptr<const regex_one_pass> lexer::nfa_to_one_pass(const regex_nfa& nfa)
+{
+  using state_type = regex_one_pass::state_type;
+
+  const auto& fragments = nfa.fragments();
+  auto slot_count = nfa.slot_count();
+  auto classes = nfa_byte_classes({ &nfa });
+  size_t class_count = *max_element(classes.begin(), classes.end()) + 1u;
+
+  // each state is the fragment a thread enters after reading some input (or the head), and
+  // states are numbered in the order they are discovered
+  vector<state_type> states(fragments.size(), regex_one_pass::no_state);
+  vector<const regex_nfa_fragment*> entries;
+  auto state_for = [&] (const regex_nfa_fragment* entry) {
+    if (states[entry->index] == regex_one_pass::no_state)
+    {
+      states[entry->index] = static_cast<state_type>(entries.size());
+      entries.push_back(entry);
+    }
+    return states[entry->index];
+  };
+
+  vector<state_type> transitions;
+  vector<size_t> transition_actions;
+  vector<size_t> accept_actions;
+  vector<size_t> action_offsets { 0 };
+  vector<size_t> actions;
+  auto add_actions = [&] (const vector<size_t>& slots) {
+    actions.insert(actions.end(), slots.begin(), slots.end());
+    action_offsets.push_back(actions.size());
+    return action_offsets.size() - 2;
+  };
+
+  // the empty NFA (with no fragments) cannot occur, since every NFA has a terminal fragment
+  vector<size_t> marks(fragments.size(), 0);
+  vector<pair<const regex_nfa_fragment*, vector<size_t>>> stack;
+  state_for(nfa.head());
+  for (size_t state = 0; state < entries.size(); state++)
+  {
+    transitions.resize((state + 1) * class_count, regex_one_pass::no_state);
+    transition_actions.resize((state + 1) * class_count, regex_one_pass::no_actions);
+    accept_actions.push_back(regex_one_pass::no_actions);
+
+    // follow epsilon links in priority order, exactly as the Pike VM does, collecting the slots
+    // saved along the way - this stops at the terminal fragment, since the Pike VM drops all
+    // lower priority threads once one of them matches
+    auto mark = state + 1;
+    stack.emplace_back(entries[state], vector<size_t>());
+    while (!stack.empty())
+    {
+      auto frag = stack.back().first;
+      auto slots = move(stack.back().second);
+      stack.pop_back();
+      if (marks[frag->index] == mark)
+        continue;
+      marks[frag->index] = mark;
+
+      if (frag->is_terminal())
+      {
+        accept_actions.back() = add_actions(slots);
+        stack.clear();
+        break;
+      }
+
+      if (frag->is_epsilon())
+      {
+        if (frag->is_save())
+          slots.push_back(frag->slot);
+        stack.emplace_back(frag->link2.output, slots);
+        stack.emplace_back(frag->link1.output, move(slots));
+        continue;
+      }
+
+      // symbol fragment - if any of its bytes already has a transition, the NFA is not one-pass
+      size_t list = regex_one_pass::no_actions;
+      for (unsigned ch = 0; ch <= numeric_limits<unsigned char>::max(); ch++)
+      {
+        if (!frag->link1.matches(static_cast<unsigned char>(ch)))
+          continue;
+        auto transition = state * class_count + classes[ch];
+        if (transitions[transition] != regex_one_pass::no_state)
+        {
+          if (transition_actions[transition] == list)
+            continue;
+          return nullptr;
+        }
+        if (list == regex_one_pass::no_actions)
+          list = add_actions(slots);
+        transitions[transition] = state_for(frag->link1.output);
+        transition_actions[transition] = list;
+      }
+    }
+  }
+
+  return make_unique<const regex_one_pass>(slot_count,
+                                           move(classes),
+                                           class_count,
+                                           move(transitions),
+                                           move(transition_actions),
+                                           move(accept_actions),
+                                           move(action_offsets),
+                                           move(actions));
+}
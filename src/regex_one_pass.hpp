@@ -0,0 +1,125 @@
+/**
+ * @file	regex_one_pass.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/21
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "regex_nfa.hpp"
+#include "regex_pike_vm.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing a DFA for a one-pass NFA with captures, which records capture positions as
+   * it matches.
+   *
+   * An NFA is one-pass if, wherever a Pike VM (see `regex_pike_vm.hpp`) could be, at most one of
+   * its threads can proceed on each input byte - e.g. `([a-z]+)=([0-9]+)` is one-pass, but
+   * `(a*)(a*)` is not, since after reading an `a` there is no way to tell which group it belongs
+   * to. For such NFAs, the Pike VM never has more than one thread, so each of its states is simply
+   * an NFA fragment, and the save fragments passed through on the way to the next state can be
+   * attached to the transition. Matching then takes one table lookup per byte, plus the slot
+   * updates for the transition, and reports exactly the same submatches as the Pike VM.
+   *
+   * @note
+   * A `lexer::regex_one_pass` is immutable once constructed, and may be used by several threads.
+   */
+  class regex_one_pass
+  {
+
+    /* -- Typedefs -- */
+
+  public:
+
+    /** The type used to represent a state. */
+    using state_type = std::uint32_t;
+
+    /* -- Constants -- */
+
+  public:
+
+    /** Marker for a missing transition. */
+    static const state_type no_state;
+
+    /** Marker for a state which does not accept. */
+    static const std::size_t no_actions;
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_one_pass` instance with the specified tables. */
+    regex_one_pass(std::size_t slot_count,
+                   std::vector<std::uint8_t> classes,
+                   std::size_t class_count,
+                   std::vector<state_type> transitions,
+                   std::vector<std::size_t> transition_actions,
+                   std::vector<std::size_t> accept_actions,
+                   std::vector<std::size_t> action_offsets,
+                   std::vector<std::size_t> actions);
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the number of states. The start state is always state 0. */
+    std::size_t state_count() const
+    {
+      return m_accept_actions.size();
+    }
+
+    /**
+     * Check if the characters in the specified range match, reporting the submatch for each group.
+     *
+     * This gives the same results as `lexer::regex_pike_vm::match`.
+     */
+    bool match(const char* begin, const char* end, std::vector<lexer::regex_submatch>& submatches) const;
+
+    /** Check if a string matches, reporting the submatch for each group. */
+    bool match(const std::string& str, std::vector<lexer::regex_submatch>& submatches) const;
+
+    /* -- Implementation -- */
+
+  private:
+
+    // every transition and accepting state refers to a list of capture slots which are set to the
+    // current position - list `n` is `m_actions[m_action_offsets[n]]` up to (but not including)
+    // `m_actions[m_action_offsets[n + 1]]`
+
+    std::size_t m_slot_count;
+    std::vector<std::uint8_t> m_classes;
+    std::size_t m_class_count;
+    std::vector<state_type> m_transitions;
+    std::vector<std::size_t> m_transition_actions;
+    std::vector<std::size_t> m_accept_actions;
+    std::vector<std::size_t> m_action_offsets;
+    std::vector<std::size_t> m_actions;
+
+  };
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Builds the one-pass DFA for an NFA, or returns `nullptr` if the NFA is not one-pass.
+   */
+  std::unique_ptr<const lexer::regex_one_pass> nfa_to_one_pass(const lexer::regex_nfa& nfa);
+
+}
@@ -0,0 +1,67 @@
+/**
+ * @file	regex_options.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/08
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Struct containing options for compiling regular expressions.
+   */
+  struct regex_options
+  {
+
+    /* -- Constants -- */
+
+    /** Default value for `max_fragments`. */
+    static const std::size_t default_max_fragments = 100000;
+
+    /* -- Fields -- */
+
+    /**
+     * Maximum number of fragments in a compiled NFA.
+     *
+     * Compilation fails with an exception if this would be exceeded. Bounded repetitions check
+     * their full expanded size before any fragments are created, so `a{1000}{1000}` fails
+     * immediately rather than after allocating most of an enormous NFA.
+     */
+    std::size_t max_fragments { default_max_fragments };
+
+    /**
+     * Whether `lexer::regex_pattern` may match with a bit-parallel simulation of the pattern's
+     * Glushkov automaton (see `regex_bit_parallel.hpp`) instead of a lazily built DFA, when the
+     * automaton is small enough.
+     */
+    bool bit_parallel { true };
+
+    /**
+     * Whether `lexer::parse_regex` adds save fragments recording where the whole match and each
+     * parenthesized group start and end, for matching with `lexer::regex_pike_vm`.
+     *
+     * This has no effect on `lexer::postfix_to_nfa`, since the postfix notation does not retain
+     * the groups.
+     */
+    bool captures { false };
+
+    /**
+     * Whether regular expressions are UTF-8, so that literal characters, the wildcard and
+     * character classes match whole code points (see `regex_utf8.hpp`).
+     *
+     * The automata still consume one byte at a time - each code point class is compiled into the
+     * alternation of the byte sequences which encode it.
+     */
+    bool utf8 { false };
+
+  };
+
+}
@@ -0,0 +1,281 @@
+/**
+ * @file	regex_parser.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/18
+ */
+
+/* -- Includes -- */
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "diagnostic.hpp"
+#include "regex_charset.hpp"
+#include "regex_constants.hpp"
+#include "regex_nfa.hpp"
+#include "regex_nfa_builder.hpp"
+#include "regex_options.hpp"
+#include "regex_parser.hpp"
+#include "regex_postfix.hpp"
+#include "regex_utf8.hpp"
+#include "result.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Types -- */
+
+namespace
+{
+
+  /** Struct representing a group (or the whole expression) which is being parsed. */
+  struct group
+  {
+
+    /** The position of the group's open bracket. */
+    size_t position;
+
+    /** The number of the group, counting open brackets from 1 (0 is the whole expression). */
+    size_t number;
+
+    /** The alternatives which have been parsed so far. */
+    vector<regex_nfa_builder::part> alternatives;
+
+    /** The concatenation of the items in the current alternative, if there are any yet. */
+    regex_nfa_builder::part sequence;
+
+    /** `true` if the current alternative has any items yet. */
+    bool has_sequence;
+
+  };
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns a diagnostic for a syntax error at the specified position. */
+  diagnostic syntax_error(diagnostic_kind kind, size_t pos)
+  {
+    return { kind, pos, 1, 0, static_cast<int>(pos) };
+  }
+
+  /**
+   * Parses a regular expression, building its NFA as it goes.
+   *
+   * Syntax errors, including invalid atoms and repetitions, are returned rather than thrown. Only
+   * the NFA builder's size limit is thrown, with `idx` left at the position being parsed.
+   */
+  result<regex_nfa> parse(const string& regex, const regex_options& options, size_t& idx)
+  {
+    static const auto any_set = regex_atom_charset(regex_constants::any_class, 0);
+
+    regex_nfa_builder builder(options);
+    vector<group> groups;
+    size_t group_count = 0;
+    groups.push_back({ 0, 0, { }, { }, false });
+
+    // local procedure to end the current alternative of the innermost group - returns `false` if
+    // the alternative is empty
+    auto end_alternative = [&] () {
+      auto& current = groups.back();
+      if (!current.has_sequence)
+        return false;
+      current.alternatives.push_back(current.sequence);
+      current.has_sequence = false;
+      return true;
+    };
+
+    // local procedure to join the alternatives of the innermost group
+    // - alternation is right associative, to build the same NFA as the postfix notation
+    // - the group is wrapped in save fragments if we are recording captures
+    auto join_alternatives = [&] () {
+      const auto& alternatives = groups.back().alternatives;
+      auto result = alternatives.back();
+      for (auto idx = alternatives.size() - 1; idx-- > 0; )
+        result = builder.alternate(alternatives[idx], result);
+      if (options.captures)
+        result = builder.capture(result, groups.back().number);
+      return result;
+    };
+
+    // local procedure to apply any postfix operators following the item ending at `idx`, and then
+    // append the item to the current alternative - returns `false` if a repetition is invalid,
+    // setting `error`
+    diagnostic error;
+    auto append_item = [&] (regex_nfa_builder::part e, size_t& idx) {
+      for (bool done = false; !done && idx + 1 < regex.size(); )
+      {
+        switch (regex[idx + 1])
+        {
+        case regex_constants::optional_op:
+          e = builder.optional(e);
+          idx++;
+          break;
+        case regex_constants::kleene_op:
+          e = builder.kleene(e);
+          idx++;
+          break;
+        case regex_constants::repeat_op:
+          e = builder.repeat(e);
+          idx++;
+          break;
+        case regex_constants::open_repetition_op:
+        {
+          auto repetition = try_parse_regex_repetition(regex, idx + 1);
+          if (!repetition)
+          {
+            error = repetition.error();
+            return false;
+          }
+          e = builder.repetition(e, repetition.value());
+          idx += repetition.value().length;
+          break;
+        }
+        default:
+          done = true;
+          break;
+        }
+      }
+
+      auto& current = groups.back();
+      current.sequence = (current.has_sequence ? builder.concat(current.sequence, e) : e);
+      current.has_sequence = true;
+      return true;
+    };
+
+    // local procedure to build the alternation of the byte sequences for the UTF-8 atom at `idx`,
+    // leaving `idx` at its last byte - returns `false` if the atom is invalid, setting `error`
+    auto utf8_atom = [&] (size_t& idx, regex_nfa_builder::part& atom) {
+      size_t length = 0;
+      auto sequences = try_regex_utf8_atom(regex, idx, length);
+      if (!sequences)
+      {
+        error = sequences.error();
+        return false;
+      }
+      idx += length - 1;
+
+      vector<regex_nfa_builder::part> parts;
+      for (const auto& sequence : sequences.value())
+      {
+        auto e = builder.atom(sequence.front());
+        for (size_t byte = 1; byte < sequence.size(); byte++)
+          e = builder.concat(e, builder.atom(sequence[byte]));
+        parts.push_back(e);
+      }
+
+      atom = parts.back();
+      for (auto part = parts.size() - 1; part-- > 0; )
+        atom = builder.alternate(parts[part], atom);
+      return true;
+    };
+
+    for (idx = 0; idx < regex.size(); idx++)
+    {
+      switch (regex[idx])
+      {
+
+      case regex_constants::open_bracket:
+        groups.push_back({ idx, ++group_count, { }, { }, false });
+        break;
+
+      case regex_constants::close_bracket:
+      {
+        if (groups.size() == 1)
+          return syntax_error(diagnostic_kind::regex_unmatched_close_bracket, idx);
+        if (!end_alternative())
+          return syntax_error(diagnostic_kind::regex_empty_alternative, idx);
+        auto e = join_alternatives();
+        groups.pop_back();
+        if (!append_item(e, idx))
+          return error;
+        break;
+      }
+
+      case regex_constants::union_op:
+        if (!end_alternative())
+          return syntax_error(diagnostic_kind::regex_empty_alternative, idx);
+        break;
+
+      case regex_constants::optional_op:
+      case regex_constants::kleene_op:
+      case regex_constants::repeat_op:
+      case regex_constants::open_repetition_op:
+        return syntax_error(diagnostic_kind::regex_nothing_to_repeat, idx);
+
+      case regex_constants::any:
+        if (options.utf8)
+        {
+          regex_nfa_builder::part e { };
+          if (!utf8_atom(idx, e) || !append_item(e, idx))
+            return error;
+        }
+        else if (!append_item(builder.atom(any_set), idx))
+          return error;
+        break;
+
+      default:
+      {
+        if (options.utf8)
+        {
+          regex_nfa_builder::part e { };
+          if (!utf8_atom(idx, e) || !append_item(e, idx))
+            return error;
+          break;
+        }
+
+        size_t length = 0;
+        auto set = try_regex_atom_charset(regex, idx, length);
+        if (!set)
+          return set.error();
+        idx += length - 1;
+        if (!append_item(builder.atom(set.value()), idx))
+          return error;
+        break;
+      }
+
+      }
+    }
+
+    if (groups.size() > 1)
+      return syntax_error(diagnostic_kind::regex_unmatched_open_bracket, groups.back().position);
+    if (!end_alternative())
+      return syntax_error(diagnostic_kind::regex_empty_alternative, regex.size());
+
+    return builder.finish(join_alternatives());
+  }
+
+}
+
+/* -- Procedures -- */
+
+regex_nfa lexer::parse_regex(const string& regex, const regex_options& options)
+{
+  size_t idx = 0;
+  auto nfa = parse(regex, options, idx);
+  if (!nfa)
+    throw runtime_error(diagnostic_message(nfa.error(), regex));
+  return move(nfa.value());
+}
+
+result<regex_nfa> lexer::try_parse_regex(const string& regex, const regex_options& options)
+{
+  // the builder's size limit is the only error which is still thrown - it depends on the options
+  // rather than the syntax, and is rare enough that catching it costs nothing in practice
+  size_t idx = 0;
+  try
+  {
+    return parse(regex, options, idx);
+  }
+  catch (const runtime_error&)
+  {
+    return syntax_error(diagnostic_kind::regex_too_large, idx);
+  }
+}
@@ -0,0 +1,52 @@
+/**
+ * @file	regex_parser.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/18
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <string>
+
+#include "regex_nfa.hpp"
+#include "regex_options.hpp"
+#include "result.hpp"
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Parses a regular expression, building its NFA as it goes.
+   *
+   * This builds exactly the same NFA as `lexer::postfix_to_nfa(lexer::regex_to_postfix(regex))`,
+   * but in a single pass over the regular expression, without building the postfix notation.
+   * Groups are tracked with an explicit stack rather than by recursion, so deeply nested
+   * expressions cannot overflow the call stack.
+   *
+   * If `options.captures` is set, the NFA also records where the whole match and each group start
+   * and end. Groups are numbered from 1 in the order of their open brackets.
+   *
+   * @exception std::runtime_error
+   * Thrown if the regular expression is invalid. The message includes the position of the error.
+   */
+  lexer::regex_nfa parse_regex(const std::string& regex,
+                               const lexer::regex_options& options = lexer::regex_options());
+
+  /**
+   * Parses a regular expression like `lexer::parse_regex`, but returns a diagnostic rather than
+   * throwing if it is invalid.
+   *
+   * Syntax errors, including invalid escapes, character classes, repetitions and UTF-8 sequences,
+   * are reported with their own diagnostic kinds without throwing at all. A regular expression
+   * which exceeds `options.max_fragments` is reported as `lexer::diagnostic_kind::regex_too_large`
+   * at the position of the item which was being parsed.
+   */
+  lexer::result<lexer::regex_nfa> try_parse_regex(
+    const std::string& regex,
+    const lexer::regex_options& options = lexer::regex_options());
+
+}
@@ -0,0 +1,326 @@
+/**
+ * @file	regex_pattern.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/12
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "regex_ast.hpp"
+#include "regex_bit_parallel.hpp"
+#include "regex_dfa.hpp"
+#include "regex_glushkov.hpp"
+#include "regex_nfa.hpp"
+#include "regex_one_pass.hpp"
+#include "regex_options.hpp"
+#include "regex_pattern.hpp"
+#include "regex_pike_vm.hpp"
+#include "regex_prefilter.hpp"
+#include "regex_utf8.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Constants -- */
+
+namespace
+{
+
+  /** Maximum number of lazily built DFA states a matcher caches before starting over. */
+  const size_t max_cached_states = 4096;
+
+}
+
+/* -- Types -- */
+
+struct regex_matcher::implementation
+{
+
+  /* -- Typedefs -- */
+
+  using state_type = int32_t;
+  using set_type = vector<size_t>;
+
+  /* -- Constants -- */
+
+  /** The state with no live NFA fragments. This is always state 0. */
+  static const state_type dead_state = 0;
+
+  /** Marker for a transition which has not been computed yet. */
+  static const state_type unknown_state = -1;
+
+  /* -- Constructor -- */
+
+  implementation(shared_ptr<const regex_pattern> pattern)
+    : pattern(move(pattern))
+  {
+    clear();
+  }
+
+  /* -- Fields -- */
+
+  /** The pattern being matched. */
+  shared_ptr<const regex_pattern> pattern;
+
+  /** The Pike VM for matching with captures, if it has been needed yet. */
+  unique_ptr<regex_pike_vm> pike_vm;
+
+  /** Map from sets of NFA fragment indices to cached states. */
+  map<set_type, state_type> states;
+
+  /** The set of NFA fragment indices for each cached state. */
+  vector<set_type> sets;
+
+  /** Whether each cached state contains the terminal fragment. */
+  vector<bool> accepting;
+
+  /** Transition table, indexed by state and byte class. */
+  vector<state_type> transitions;
+
+  /** The start state. */
+  state_type start;
+
+  /** Scratch space for computing transitions. */
+  vector<const regex_nfa_fragment*> targets;
+  unique_ptr<regex_nfa_closure> closures;
+
+  /* -- Methods -- */
+
+  /** Discards all cached states. */
+  void clear()
+  {
+    pike_vm.reset();
+    states.clear();
+    sets.clear();
+    accepting.clear();
+    transitions.clear();
+    closures = make_unique<regex_nfa_closure>(pattern->nfa());
+
+    add_state(set_type());
+    start = add_state(closure({ pattern->nfa().head() }));
+  }
+
+  /** Returns the union of the epsilon closures of the specified fragments. */
+  set_type closure(const vector<const regex_nfa_fragment*>& entries)
+  {
+    set_type result;
+    closures->clear();
+    for (const auto* entry : entries)
+      closures->add(entry, [&] (size_t index) { result.push_back(index); });
+
+    sort(result.begin(), result.end());
+    return result;
+  }
+
+  /** Returns the state for the specified set, adding it if it is not already cached. */
+  state_type add_state(set_type set)
+  {
+    auto it = states.find(set);
+    if (it != states.end())
+      return it->second;
+
+    const auto& fragments = pattern->nfa().fragments();
+    bool is_accepting = any_of(set.begin(), set.end(), [&] (size_t index) {
+        return fragments[index]->is_terminal();
+      });
+
+    auto state = static_cast<state_type>(sets.size());
+    states.emplace(set, state);
+    sets.push_back(move(set));
+    accepting.push_back(is_accepting);
+    transitions.resize(transitions.size() + pattern->class_count(), unknown_state);
+    return state;
+  }
+
+  /** Returns the state reached from the specified state on the specified byte. */
+  state_type next_state(state_type state, unsigned char ch)
+  {
+    auto cls = pattern->classes()[ch];
+    auto next = transitions[state * pattern->class_count() + cls];
+    if (next != unknown_state)
+      return next;
+
+    // start over if the cache is full, keeping only the state we are in
+    if (sets.size() >= max_cached_states)
+    {
+      auto set = sets[state];
+      clear();
+      state = add_state(move(set));
+    }
+
+    const auto& fragments = pattern->nfa().fragments();
+    targets.clear();
+    for (auto index : sets[state])
+    {
+      const auto* frag = fragments[index].get();
+      if (frag->is_symbol() && frag->link1.matches(ch))
+        targets.push_back(frag->link1.output);
+    }
+
+    next = add_state(closure(targets));
+    transitions[state * pattern->class_count() + cls] = next;
+    return next;
+  }
+
+  /** Check if a match starts at the beginning of the specified range. */
+  bool match(const char* begin, const char* end)
+  {
+    if (auto bit_parallel = pattern->bit_parallel())
+      return bit_parallel->match(begin, end);
+
+    auto state = start;
+    if (accepting[state])
+      return true;
+
+    for (auto it = begin; it != end; it++)
+    {
+      state = next_state(state, static_cast<unsigned char>(*it));
+      if (accepting[state])
+        return true;
+      if (state == dead_state)
+        return false;
+    }
+
+    return false;
+  }
+
+};
+
+const regex_matcher::implementation::state_type regex_matcher::implementation::dead_state;
+const regex_matcher::implementation::state_type regex_matcher::implementation::unknown_state;
+
+/* -- Procedures -- */
+
+shared_ptr<const regex_pattern> regex_pattern::compile(const string& regex,
+                                                       const regex_options& options)
+{
+  // patterns are compiled once and matched many times, so it is worth simplifying them first
+  auto postfix = regex_to_simplified_postfix(options.utf8 ? regex_utf8_to_bytes(regex) : regex);
+  auto nfa = postfix_to_nfa(postfix, options);
+  auto prefilter = postfix_to_prefilter(postfix);
+
+  // each symbol fragment of the NFA becomes one position of the Glushkov automaton, so there is
+  // no need to build the automaton if there are too many of them
+  unique_ptr<const regex_bit_parallel> bit_parallel;
+  if (options.bit_parallel)
+  {
+    const auto& fragments = nfa.fragments();
+    auto symbols = count_if(fragments.begin(), fragments.end(), [] (const auto& frag) {
+        return frag->is_symbol();
+      });
+    if (static_cast<size_t>(symbols) <= regex_bit_parallel::max_positions)
+      bit_parallel = make_unique<const regex_bit_parallel>(postfix_to_glushkov(postfix, options));
+  }
+
+  // patterns with captures also need the NFA with the groups in place, which is built from the
+  // original regular expression, since simplification does not preserve the groups
+  unique_ptr<const regex_nfa> capture_nfa;
+  unique_ptr<const regex_one_pass> one_pass;
+  if (options.captures)
+  {
+    capture_nfa = make_unique<const regex_nfa>(regex_to_nfa(regex, options));
+    one_pass = nfa_to_one_pass(*capture_nfa);
+  }
+
+  return shared_ptr<const regex_pattern>(
+    new regex_pattern(regex,
+                      move(nfa),
+                      move(prefilter),
+                      move(bit_parallel),
+                      move(capture_nfa),
+                      move(one_pass)));
+}
+
+regex_pattern::regex_pattern(string regex,
+                             regex_nfa nfa,
+                             regex_prefilter prefilter,
+                             unique_ptr<const regex_bit_parallel> bit_parallel,
+                             unique_ptr<const regex_nfa> capture_nfa,
+                             unique_ptr<const regex_one_pass> one_pass)
+  : m_regex(move(regex)),
+    m_nfa(move(nfa)),
+    m_prefilter(move(prefilter)),
+    m_bit_parallel(move(bit_parallel)),
+    m_capture_nfa(move(capture_nfa)),
+    m_one_pass(move(one_pass)),
+    m_classes(nfa_byte_classes({ &m_nfa })),
+    m_class_count(*max_element(m_classes.begin(), m_classes.end()) + 1u)
+{
+}
+
+regex_matcher::regex_matcher(shared_ptr<const regex_pattern> pattern)
+  : impl(make_unique<implementation>(move(pattern)))
+{
+}
+
+regex_matcher::regex_matcher(regex_matcher&& other) = default;
+
+regex_matcher& regex_matcher::operator=(regex_matcher&& other) = default;
+
+regex_matcher::~regex_matcher() = default;
+
+const shared_ptr<const regex_pattern>& regex_matcher::pattern() const
+{
+  return impl->pattern;
+}
+
+void regex_matcher::reset(shared_ptr<const regex_pattern> pattern)
+{
+  impl->pattern = move(pattern);
+  impl->clear();
+}
+
+bool regex_matcher::match(const char* begin, const char* end)
+{
+  return impl->match(begin, end);
+}
+
+bool regex_matcher::match(const string& str)
+{
+  return match(str.data(), str.data() + str.size());
+}
+
+bool regex_matcher::match(const char* begin, const char* end, vector<regex_submatch>& submatches)
+{
+  const auto& pattern = impl->pattern;
+  if (auto one_pass = pattern->one_pass())
+    return one_pass->match(begin, end, submatches);
+  if (!pattern->capture_nfa())
+    throw logic_error("Pattern was not compiled with captures!");
+
+  if (!impl->pike_vm)
+    impl->pike_vm = make_unique<regex_pike_vm>(*pattern->capture_nfa());
+  return impl->pike_vm->match(begin, end, submatches);
+}
+
+bool regex_matcher::match(const string& str, vector<regex_submatch>& submatches)
+{
+  return match(str.data(), str.data() + str.size(), submatches);
+}
+
+bool regex_matcher::search(const char* begin, const char* end)
+{
+  return impl->pattern->prefilter().search(begin, end, [&] (const char* start) {
+      return impl->match(start, end);
+    });
+}
+
+bool regex_matcher::search(const string& str)
+{
+  return search(str.data(), str.data() + str.size());
+}
+
+size_t regex_matcher::cached_states() const
+{
+  return impl->sets.size();
+}
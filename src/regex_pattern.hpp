@@ -0,0 +1,212 @@
+/**
+ * @file	regex_pattern.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/12
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "regex_bit_parallel.hpp"
+#include "regex_nfa.hpp"
+#include "regex_one_pass.hpp"
+#include "regex_options.hpp"
+#include "regex_pike_vm.hpp"
+#include "regex_prefilter.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing a compiled regular expression.
+   *
+   * @note
+   * A `lexer::regex_pattern` is immutable once compiled, so a single instance can be shared by any
+   * number of threads. All mutable state used while matching lives in `lexer::regex_matcher`.
+   */
+  class regex_pattern
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Compiles the specified regular expression. */
+    static std::shared_ptr<const lexer::regex_pattern> compile(
+      const std::string& regex,
+      const lexer::regex_options& options = lexer::regex_options());
+
+  private:
+
+    /** Constructs a new `lexer::regex_pattern` instance. */
+    regex_pattern(std::string regex,
+                  lexer::regex_nfa nfa,
+                  lexer::regex_prefilter prefilter,
+                  std::unique_ptr<const lexer::regex_bit_parallel> bit_parallel,
+                  std::unique_ptr<const lexer::regex_nfa> capture_nfa,
+                  std::unique_ptr<const lexer::regex_one_pass> one_pass);
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the source regular expression. */
+    const std::string& regex() const
+    {
+      return m_regex;
+    }
+
+    /** Returns the NFA for this pattern. */
+    const lexer::regex_nfa& nfa() const
+    {
+      return m_nfa;
+    }
+
+    /** Returns the literal prefilter for this pattern. */
+    const lexer::regex_prefilter& prefilter() const
+    {
+      return m_prefilter;
+    }
+
+    /**
+     * Returns the bit-parallel matcher for this pattern, or `nullptr` if the pattern is too large
+     * (or `lexer::regex_options::bit_parallel` was not set).
+     */
+    const lexer::regex_bit_parallel* bit_parallel() const
+    {
+      return m_bit_parallel.get();
+    }
+
+    /**
+     * Returns the NFA with captures for this pattern, or `nullptr` if the pattern was not compiled
+     * with `lexer::regex_options::captures` set.
+     */
+    const lexer::regex_nfa* capture_nfa() const
+    {
+      return m_capture_nfa.get();
+    }
+
+    /**
+     * Returns the one-pass DFA for this pattern, or `nullptr` if the pattern was not compiled with
+     * captures or its NFA with captures is not one-pass.
+     */
+    const lexer::regex_one_pass* one_pass() const
+    {
+      return m_one_pass.get();
+    }
+
+    /** Returns the byte-to-class map for this pattern's NFA. */
+    const std::vector<std::uint8_t>& classes() const
+    {
+      return m_classes;
+    }
+
+    /** Returns the number of byte classes for this pattern's NFA. */
+    std::size_t class_count() const
+    {
+      return m_class_count;
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    std::string m_regex;
+    lexer::regex_nfa m_nfa;
+    lexer::regex_prefilter m_prefilter;
+    std::unique_ptr<const lexer::regex_bit_parallel> m_bit_parallel;
+    std::unique_ptr<const lexer::regex_nfa> m_capture_nfa;
+    std::unique_ptr<const lexer::regex_one_pass> m_one_pass;
+    std::vector<std::uint8_t> m_classes;
+    std::size_t m_class_count;
+
+  };
+
+  /**
+   * Class which matches strings against a compiled `lexer::regex_pattern`.
+   *
+   * Patterns with a bit-parallel matcher are matched with it directly. Otherwise, the matcher
+   * holds the scratch space needed for matching, including a lazily built DFA whose states are
+   * computed from the pattern's NFA the first time they are reached and cached for later use.
+   *
+   * A matcher must not be used by more than one thread at a time, but it is cheap to create one
+   * per thread, and `reset` lets a pooled matcher be reused for another pattern without releasing
+   * its buffers.
+   */
+  class regex_matcher
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_matcher` instance for the specified pattern. */
+    regex_matcher(std::shared_ptr<const lexer::regex_pattern> pattern);
+
+    /** Move constructor. */
+    regex_matcher(regex_matcher&& other);
+
+    /** Move assignment operator. */
+    regex_matcher& operator=(regex_matcher&& other);
+
+    /** Destructor. */
+    ~regex_matcher();
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the pattern used by this matcher. */
+    const std::shared_ptr<const lexer::regex_pattern>& pattern() const;
+
+    /** Switches this matcher to a different pattern, discarding any cached states. */
+    void reset(std::shared_ptr<const lexer::regex_pattern> pattern);
+
+    /** Check if the characters in the specified range match the pattern. */
+    bool match(const char* begin, const char* end);
+
+    /** Check if a string matches the pattern. */
+    bool match(const std::string& str);
+
+    /**
+     * Check if the characters in the specified range match the pattern, reporting the submatch
+     * for each group (see `lexer::regex_pike_vm::match`).
+     *
+     * The pattern's one-pass DFA is used if it has one, and a Pike VM otherwise.
+     *
+     * @exception std::logic_error
+     * Thrown if the pattern was not compiled with `lexer::regex_options::captures` set.
+     */
+    bool match(const char* begin, const char* end, std::vector<lexer::regex_submatch>& submatches);
+
+    /** Check if a string matches the pattern, reporting the submatch for each group. */
+    bool match(const std::string& str, std::vector<lexer::regex_submatch>& submatches);
+
+    /** Check if a match for the pattern starts anywhere in the specified range. */
+    bool search(const char* begin, const char* end);
+
+    /** Check if a match for the pattern starts anywhere in a string. */
+    bool search(const std::string& str);
+
+    /** Returns the number of DFA states currently cached by this matcher. */
+    std::size_t cached_states() const;
+
+    /* -- Implementation -- */
+
+  private:
+
+    struct implementation;
+    std::unique_ptr<implementation> impl;
+
+  };
+
+}
@@ -0,0 +1,144 @@
+/**
+ * @file	regex_pike_vm.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "regex_nfa.hpp"
+#include "regex_pike_vm.hpp"
+#include "regex_sparse_set.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Constants -- */
+
+const size_t regex_submatch::npos = numeric_limits<size_t>::max();
+
+/* -- Procedures -- */
+
+regex_pike_vm::regex_pike_vm(const regex_nfa& nfa)
+  : m_nfa(nfa),
+    m_slot_count(nfa.slot_count()),
+    m_current(nfa.fragments().size()),
+    m_next(nfa.fragments().size()),
+    m_current_slots(nfa.fragments().size() * m_slot_count),
+    m_next_slots(nfa.fragments().size() * m_slot_count),
+    m_scratch(m_slot_count),
+    m_stack()
+{
+}
+
+bool regex_pike_vm::match(const char* begin, const char* end, vector<regex_submatch>& submatches)
+{
+  const auto& fragments = m_nfa.fragments();
+  const auto length = static_cast<size_t>(end - begin);
+
+  submatches.assign(m_slot_count / 2, { regex_submatch::npos, regex_submatch::npos });
+  m_current.clear();
+  fill(m_scratch.begin(), m_scratch.end(), regex_submatch::npos);
+  add_thread(m_current, m_current_slots, m_nfa.head(), 0);
+
+  bool matched = false;
+  for (size_t pos = 0; !m_current.empty(); pos++)
+  {
+    m_next.clear();
+    for (auto index : m_current)
+    {
+      const auto& frag = *fragments[index];
+      const auto* thread_slots = m_current_slots.data() + index * m_slot_count;
+
+      // a thread reaching the terminal fragment is the best match so far - lower priority threads
+      // are dropped, but higher priority ones carry on in case they find a match of their own
+      if (frag.is_terminal())
+      {
+        matched = true;
+        for (size_t group = 0; group < submatches.size(); group++)
+        {
+          if (thread_slots[group * 2] != regex_submatch::npos &&
+              thread_slots[group * 2 + 1] != regex_submatch::npos)
+            submatches[group] = { thread_slots[group * 2], thread_slots[group * 2 + 1] };
+          else
+            submatches[group] = { regex_submatch::npos, regex_submatch::npos };
+        }
+        break;
+      }
+
+      if (pos < length && frag.is_symbol() && frag.link1.matches(begin[pos]))
+      {
+        copy(thread_slots, thread_slots + m_slot_count, m_scratch.begin());
+        add_thread(m_next, m_next_slots, frag.link1.output, pos + 1);
+      }
+    }
+
+    if (pos == length)
+      break;
+    swap(m_current, m_next);
+    swap(m_current_slots, m_next_slots);
+  }
+
+  return matched;
+}
+
+bool regex_pike_vm::match(const string& str, vector<regex_submatch>& submatches)
+{
+  return match(str.data(), str.data() + str.size(), submatches);
+}
+
+void regex_pike_vm::add_thread(regex_sparse_set& threads,
+                               vector<size_t>& slots,
+                               const regex_nfa_fragment* frag,
+                               size_t pos)
+{
+  // follows epsilon links in priority order (link1 first), with an explicit stack so that long
+  // chains of epsilon fragments cannot overflow the call stack - a save fragment updates the
+  // scratch slots, and pushes an entry restoring them once everything after it has been followed
+  m_stack.push_back({ frag, 0, 0 });
+  while (!m_stack.empty())
+  {
+    auto entry = m_stack.back();
+    m_stack.pop_back();
+    if (!entry.frag)
+    {
+      m_scratch[entry.slot] = entry.value;
+      continue;
+    }
+
+    for (auto current = entry.frag; threads.insert(current->index); )
+    {
+      if (current->is_save())
+      {
+        m_stack.push_back({ nullptr, current->slot, m_scratch[current->slot] });
+        m_scratch[current->slot] = pos;
+        current = current->link1.output;
+      }
+      else if (current->is_epsilon())
+      {
+        if (current->link2.output != current->link1.output)
+          m_stack.push_back({ current->link2.output, 0, 0 });
+        current = current->link1.output;
+      }
+      else
+      {
+        copy(m_scratch.begin(), m_scratch.end(), slots.begin() + current->index * m_slot_count);
+        break;
+      }
+    }
+  }
+}
+
+bool lexer::regex_match(const regex_nfa& nfa, const string& str, vector<regex_submatch>& submatches)
+{
+  regex_pike_vm vm(nfa);
+  return vm.match(str, submatches);
+}
@@ -0,0 +1,143 @@
+/**
+ * @file	regex_pike_vm.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "regex_nfa.hpp"
+#include "regex_sparse_set.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Struct representing the part of a string matched by a capture group.
+   */
+  struct regex_submatch
+  {
+
+    /* -- Constants -- */
+
+    /** Value of `begin` and `end` for a group which did not take part in the match. */
+    static const std::size_t npos;
+
+    /* -- Fields -- */
+
+    /** The offset of the first character matched by the group. */
+    std::size_t begin;
+
+    /** The offset one past the last character matched by the group. */
+    std::size_t end;
+
+    /* -- Public Methods -- */
+
+    /** Returns `true` if the group took part in the match. */
+    bool matched() const
+    {
+      return (begin != npos);
+    }
+
+  };
+
+  /**
+   * Class which matches strings against an NFA with captures, reporting the submatch for each
+   * group.
+   *
+   * This is a Pike VM: all threads advance through the input in lockstep, one byte at a time, and
+   * each thread carries its own copy of the capture slots. Threads are kept in priority order and
+   * at most one thread may be in each fragment, so matching takes O(n * m) time for a string of
+   * length n and an NFA with m fragments, and reports the same submatches a backtracking matcher
+   * would (alternatives are preferred from left to right, and repetitions are greedy).
+   *
+   * The slot arrays for both thread lists are allocated once, with a row per fragment, so a thread
+   * is copied into its row rather than allocating anything while matching.
+   *
+   * @note
+   * The NFA must be built with `lexer::regex_options::captures` set for any submatches to be
+   * reported, and must outlive the VM. A VM must not be used by more than one thread at a time.
+   */
+  class regex_pike_vm
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_pike_vm` instance for the specified NFA. */
+    regex_pike_vm(const lexer::regex_nfa& nfa);
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /**
+     * Check if the characters in the specified range match the NFA.
+     *
+     * As with `lexer::regex_match`, this succeeds if any prefix of the range matches. If it does,
+     * `submatches` receives the submatch for the whole match (at index 0) and for each group.
+     */
+    bool match(const char* begin, const char* end, std::vector<lexer::regex_submatch>& submatches);
+
+    /** Check if a string matches the NFA, reporting the submatch for each group. */
+    bool match(const std::string& str, std::vector<lexer::regex_submatch>& submatches);
+
+    /* -- Implementation -- */
+
+  private:
+
+    /** Struct representing an entry on the stack used to follow epsilon links. */
+    struct stack_entry
+    {
+
+      /** The fragment to follow, or `nullptr` to restore a capture slot. */
+      const lexer::regex_nfa_fragment* frag;
+
+      /** The capture slot to restore. */
+      std::size_t slot;
+
+      /** The value to restore the capture slot to. */
+      std::size_t value;
+
+    };
+
+    const lexer::regex_nfa& m_nfa;
+    std::size_t m_slot_count;
+    lexer::regex_sparse_set m_current;
+    lexer::regex_sparse_set m_next;
+    std::vector<std::size_t> m_current_slots;
+    std::vector<std::size_t> m_next_slots;
+    std::vector<std::size_t> m_scratch;
+    std::vector<stack_entry> m_stack;
+
+    void add_thread(lexer::regex_sparse_set& threads,
+                    std::vector<std::size_t>& slots,
+                    const lexer::regex_nfa_fragment* frag,
+                    std::size_t pos);
+
+  };
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Check if a string matches an NFA, reporting the submatch for each group.
+   */
+  bool regex_match(const lexer::regex_nfa& nfa,
+                   const std::string& str,
+                   std::vector<lexer::regex_submatch>& submatches);
+
+}
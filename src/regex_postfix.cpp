@@ -6,19 +6,36 @@
 
 /* -- Includes -- */
 
+#include <cctype>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "diagnostic.hpp"
+#include "regex_charset.hpp"
 #include "regex_constants.hpp"
 #include "regex_postfix.hpp"
+#include "result.hpp"
 
 /* -- Namespaces -- */
 
 using namespace std;
 using namespace lexer;
 
+/* -- Constants -- */
+
+const size_t regex_repetition::unbounded = numeric_limits<size_t>::max();
+
+namespace
+{
+
+  /** Largest count accepted in a bounded repetition operator. */
+  const size_t max_repetition_count = 100000;
+
+}
+
 /* -- Private Procedures -- */
 
 namespace
@@ -45,6 +62,7 @@ namespace
     case regex_constants::optional_op:
     case regex_constants::kleene_op:
     case regex_constants::repeat_op:
+    case regex_constants::open_repetition_op:
       return true;
     default:
       return false;
@@ -86,6 +104,12 @@ namespace
     return (ch == regex_constants::close_bracket);
   }
 
+  /** Returns `true` if the specified character is a wildcard (only valid in a regex). */
+  bool is_any(char ch)
+  {
+    return (ch == regex_constants::any);
+  }
+
   /** Returns `true` if the specified character is a normal character. */
   bool is_normal(char ch)
   {
@@ -94,6 +118,15 @@ namespace
             !is_close_bracket(ch));
   }
 
+  /** Returns the length of the atom or postfix operator starting at the specified position. */
+  size_t token_length(const string& str, size_t pos)
+  {
+    if (str[pos] == regex_constants::open_repetition_op)
+      return parse_regex_repetition(str, pos).length;
+    else
+      return regex_atom_length(str, pos);
+  }
+
   /** Returns the precedence for the specified operator. */
   int operator_precedence(char ch)
   {
@@ -102,6 +135,7 @@ namespace
     case regex_constants::optional_op:
     case regex_constants::kleene_op:
     case regex_constants::repeat_op:
+    case regex_constants::open_repetition_op:
       return 3;
     case regex_constants::concat_op:
       return 2;
@@ -133,14 +167,16 @@ string lexer::regex_to_postfix(const string& regex)
       while (m_it != m_input.cend())
       {
         char ch = *m_it;
-        if (is_infix_operator(ch))
+        if (is_any(ch))
+          handle_any();
+        else if (is_infix_operator(ch))
           handle_infix_operator(ch);
         else if (is_open_bracket(ch))
           handle_open_bracket(ch);
         else if (is_close_bracket(ch))
           handle_close_bracket(ch);
         else
-          handle_normal(ch);
+          handle_normal();
         m_it++;
       }
 
@@ -157,10 +193,19 @@ string lexer::regex_to_postfix(const string& regex)
 
   private:
 
-    /** Handles a normal character. */
-    void handle_normal(char ch)
+    /** Handles a normal character, escape sequence, character class, or postfix operator. */
+    void handle_normal()
+    {
+      auto length = token_length(m_input, m_it - m_input.cbegin());
+      m_output.append(m_it, m_it + length);
+      m_it += length - 1;
+      add_implicit_concat_if_needed();
+    }
+
+    /** Handles a wildcard, which is written to the output as a character class. */
+    void handle_any()
     {
-      m_output.push_back(ch);
+      m_output.append(regex_constants::any_class);
       add_implicit_concat_if_needed();
     }
 
@@ -197,7 +242,7 @@ string lexer::regex_to_postfix(const string& regex)
     void add_implicit_concat_if_needed()
     {
       auto next = m_it + 1;
-      if (next != m_input.end() && (is_normal(*next) || is_open_bracket(*next)))
+      if (next != m_input.end() && (is_normal(*next) || is_any(*next) || is_open_bracket(*next)))
         handle_infix_operator(regex_constants::concat_op);
     }
 
@@ -223,8 +268,9 @@ string lexer::regex_to_postfix(const string& regex)
 string lexer::postfix_to_regex(const string& postfix)
 {
   vector<string> stack;
-  for (auto ch : postfix)
+  for (size_t idx = 0; idx < postfix.size(); idx++)
   {
+    char ch = postfix[idx];
     if (is_infix_operator(ch))
     {
       if (stack.size() < 2)
@@ -249,16 +295,20 @@ string lexer::postfix_to_regex(const string& postfix)
       if (stack.size() < 1)
         throw runtime_error("Regular expression is invalid!");
 
+      auto length = token_length(postfix, idx);
       const auto& operand = *(stack.crbegin());
       ostringstream token;
-      token << operand << ch;
+      token << operand << postfix.substr(idx, length);
+      idx += length - 1;
 
       stack.pop_back();
       stack.push_back(token.str());
     }
     else
     {
-      stack.push_back(string(1, ch));
+      auto length = regex_atom_length(postfix, idx);
+      stack.push_back(postfix.substr(idx, length));
+      idx += length - 1;
     }
   }
 
@@ -266,3 +316,59 @@ string lexer::postfix_to_regex(const string& postfix)
     throw runtime_error("Regular expression is invalid!");
   return stack.back();
 }
+
+regex_repetition lexer::parse_regex_repetition(const string& regex, size_t pos)
+{
+  auto repetition = try_parse_regex_repetition(regex, pos);
+  if (!repetition)
+    throw runtime_error(diagnostic_message(repetition.error(), regex));
+  return repetition.value();
+}
+
+result<regex_repetition> lexer::try_parse_regex_repetition(const string& regex, size_t pos)
+{
+  size_t idx = pos + 1;
+  diagnostic error { diagnostic_kind::regex_invalid_repetition, pos, 1, 0, static_cast<int>(pos) };
+
+  // local procedure to read a decimal count, returning `false` if there are no digits or the
+  // count is too large
+  auto read_count = [&] (size_t& count) -> bool {
+    auto start = idx;
+    count = 0;
+    while (idx < regex.size() && isdigit(static_cast<unsigned char>(regex[idx])))
+    {
+      count = (count * 10) + static_cast<size_t>(regex[idx] - '0');
+      if (count > max_repetition_count)
+      {
+        error.kind = diagnostic_kind::regex_repetition_too_large;
+        return false;
+      }
+      idx++;
+    }
+    return (idx != start);
+  };
+
+  regex_repetition repetition;
+  if (!read_count(repetition.min))
+    return error;
+
+  repetition.max = repetition.min;
+  if (idx < regex.size() && regex[idx] == regex_constants::repetition_separator)
+  {
+    idx++;
+    if (!read_count(repetition.max))
+    {
+      if (error.kind == diagnostic_kind::regex_repetition_too_large)
+        return error;
+      repetition.max = regex_repetition::unbounded;
+    }
+  }
+
+  if (idx >= regex.size() ||
+      regex[idx] != regex_constants::close_repetition_op ||
+      repetition.max < repetition.min)
+    return error;
+
+  repetition.length = idx + 1 - pos;
+  return repetition;
+}
@@ -8,8 +8,38 @@
 
 /* -- Includes -- */
 
+#include <cstddef>
 #include <string>
 
+#include "result.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Struct representing a bounded repetition operator (`{m}`, `{m,}` or `{m,n}`).
+   */
+  struct regex_repetition
+  {
+
+    /** Value of `max` for a repetition without an upper bound (`{m,}`). */
+    static const std::size_t unbounded;
+
+    /** Minimum number of repetitions. */
+    std::size_t min;
+
+    /** Maximum number of repetitions, or `unbounded`. */
+    std::size_t max;
+
+    /** Length of the operator in the regular expression. */
+    std::size_t length;
+
+  };
+
+}
+
 /* -- Procedure Prototypes -- */
 
 namespace lexer
@@ -17,6 +47,11 @@ namespace lexer
 
   /**
    * Convert a regular expression to postfix notation.
+   *
+   * @note
+   * Escape sequences and character classes are atoms, and are copied to the output unchanged. The
+   * wildcard is written as the equivalent character class, since `.` is the concatenation operator
+   * in postfix notation.
    */
   std::string regex_to_postfix(const std::string& regex);
 
@@ -25,4 +60,16 @@ namespace lexer
    */
   std::string postfix_to_regex(const std::string& postfix);
 
+  /**
+   * Parses the bounded repetition operator starting at the specified position.
+   */
+  lexer::regex_repetition parse_regex_repetition(const std::string& regex, std::size_t pos);
+
+  /**
+   * Parses the bounded repetition operator starting at the specified position like
+   * `lexer::parse_regex_repetition`, but returns a diagnostic rather than throwing if it is invalid.
+   */
+  lexer::result<lexer::regex_repetition> try_parse_regex_repetition(const std::string& regex,
+                                                                    std::size_t pos);
+
 }
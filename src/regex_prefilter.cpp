@@ -0,0 +1,264 @@
+/**
+ * @file	regex_prefilter.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/10
+ */
+
+/* -- Includes -- */
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "regex_charset.hpp"
+#include "regex_constants.hpp"
+#include "regex_dfa.hpp"
+#include "regex_postfix.hpp"
+#include "regex_prefilter.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Constants -- */
+
+const size_t regex_prefilter::npos = string::npos;
+
+/* -- Private Types -- */
+
+namespace
+{
+
+  /** Struct describing the literal strings known to be part of every match of a subexpression. */
+  struct literal_info
+  {
+
+    /** `true` if the subexpression only matches one string (which is `prefix`). */
+    bool exact;
+
+    /** String which every match starts with. */
+    string prefix;
+
+    /** String which every match ends with. */
+    string suffix;
+
+    /** String which every match contains. */
+    string required;
+
+  };
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns the longer of two strings (preferring the first). */
+  const string& longer(const string& str1, const string& str2)
+  {
+    return (str2.size() > str1.size() ? str2 : str1);
+  }
+
+  /** Returns the literal info for a subexpression only matching the specified string. */
+  literal_info exact_info(string literal)
+  {
+    return { true, literal, literal, literal };
+  }
+
+  /** Returns the literal info for a subexpression about which nothing is known. */
+  literal_info unknown_info()
+  {
+    return { false, string(), string(), string() };
+  }
+
+  /** Returns the literal info for the concatenation of two subexpressions. */
+  literal_info concat_info(const literal_info& e1, const literal_info& e2)
+  {
+    if (e1.exact && e2.exact)
+      return exact_info(e1.prefix + e2.prefix);
+
+    literal_info info;
+    info.exact = false;
+    info.prefix = (e1.exact ? e1.prefix + e2.prefix : e1.prefix);
+    info.suffix = (e2.exact ? e1.suffix + e2.suffix : e2.suffix);
+    info.required = longer(longer(e1.required, e2.required), e1.suffix + e2.prefix);
+    info.required = longer(longer(info.required, info.prefix), info.suffix);
+    return info;
+  }
+
+  /** Returns the literal info for the alternation of two subexpressions. */
+  literal_info union_info(const literal_info& e1, const literal_info& e2)
+  {
+    if (e1.exact && e2.exact && e1.prefix == e2.prefix)
+      return e1;
+
+    literal_info info;
+    info.exact = false;
+
+    size_t length = 0;
+    while (length < e1.prefix.size() && length < e2.prefix.size() &&
+           e1.prefix[length] == e2.prefix[length])
+      length++;
+    info.prefix = e1.prefix.substr(0, length);
+
+    length = 0;
+    while (length < e1.suffix.size() && length < e2.suffix.size() &&
+           e1.suffix[e1.suffix.size() - length - 1] == e2.suffix[e2.suffix.size() - length - 1])
+      length++;
+    info.suffix = e1.suffix.substr(e1.suffix.size() - length);
+
+    info.required = longer(info.prefix, info.suffix);
+    return info;
+  }
+
+  /** Returns the literal info for one or more repetitions of a subexpression. */
+  literal_info repeat_info(const literal_info& e)
+  {
+    literal_info info = e;
+    info.exact = false;
+    return info;
+  }
+
+}
+
+/* -- Procedures -- */
+
+size_t regex_prefilter::find_prefix(const char* data, size_t size, size_t pos) const
+{
+  if (pos > size)
+    return npos;
+  if (m_prefix.empty())
+    return pos;
+
+  const void* found = nullptr;
+  if (m_prefix.size() == 1)
+    found = memchr(data + pos, m_prefix[0], size - pos);
+  else
+    found = memmem(data + pos, size - pos, m_prefix.data(), m_prefix.size());
+
+  return (found ? static_cast<const char*>(found) - data : npos);
+}
+
+size_t regex_prefilter::find_required(const char* data, size_t size, size_t pos) const
+{
+  if (pos > size)
+    return npos;
+  if (m_required.empty())
+    return pos;
+
+  const void* found = memmem(data + pos, size - pos, m_required.data(), m_required.size());
+  return (found ? static_cast<const char*>(found) - data : npos);
+}
+
+regex_prefilter lexer::postfix_to_prefilter(const string& postfix)
+{
+  vector<literal_info> stack;
+
+  // local procedure to pop an operand off of the stack
+  auto pop_info = [&] () -> literal_info {
+    if (stack.empty())
+      throw runtime_error("Regular expression is invalid!");
+    auto info = stack.back();
+    stack.pop_back();
+    return info;
+  };
+
+  for (size_t idx = 0; idx < postfix.size(); idx++)
+  {
+    switch (postfix[idx])
+    {
+
+    case regex_constants::concat_op:
+    {
+      auto e2 = pop_info();
+      auto e1 = pop_info();
+      stack.push_back(concat_info(e1, e2));
+      break;
+    }
+
+    case regex_constants::union_op:
+    {
+      auto e2 = pop_info();
+      auto e1 = pop_info();
+      stack.push_back(union_info(e1, e2));
+      break;
+    }
+
+    case regex_constants::optional_op:
+    case regex_constants::kleene_op:
+    {
+      // the subexpression may match nothing at all
+      pop_info();
+      stack.push_back(unknown_info());
+      break;
+    }
+
+    case regex_constants::repeat_op:
+    {
+      stack.push_back(repeat_info(pop_info()));
+      break;
+    }
+
+    case regex_constants::open_repetition_op:
+    {
+      auto repetition = parse_regex_repetition(postfix, idx);
+      idx += repetition.length - 1;
+
+      auto e = pop_info();
+      stack.push_back(repetition.min == 0 ? unknown_info() : repeat_info(e));
+      break;
+    }
+
+    default:
+    {
+      size_t length = 0;
+      auto set = regex_atom_charset(postfix, idx, length);
+      idx += length - 1;
+
+      if (set.count() == 1)
+      {
+        size_t ch = 0;
+        while (!set.test(ch))
+          ch++;
+        stack.push_back(exact_info(string(1, static_cast<char>(ch))));
+      }
+      else
+        stack.push_back(unknown_info());
+      break;
+    }
+
+    }
+  }
+
+  if (stack.size() != 1)
+    throw runtime_error("Regular expression is invalid!");
+
+  const auto& info = stack.back();
+  return regex_prefilter(info.prefix, info.required);
+}
+
+regex_prefilter lexer::regex_to_prefilter(const string& regex)
+{
+  return postfix_to_prefilter(regex_to_postfix(regex));
+}
+
+bool lexer::regex_search(const regex_dfa& dfa,
+                         const regex_prefilter& prefilter,
+                         const char* begin,
+                         const char* end)
+{
+  return prefilter.search(begin, end, [&] (const char* start) {
+      return regex_match(dfa, start, end);
+    });
+}
+
+bool lexer::regex_search(const string& regex, const string& str)
+{
+  auto postfix = regex_to_postfix(regex);
+  auto dfa = regex_to_dfa(regex);
+  auto prefilter = postfix_to_prefilter(postfix);
+  return regex_search(dfa, prefilter, str.data(), str.data() + str.size());
+}
@@ -0,0 +1,153 @@
+/**
+ * @file	regex_prefilter.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/10
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "regex_dfa.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing literal strings which every match of a regular expression must contain.
+   *
+   * A search uses these to skip over input which cannot contain a match with fast substring
+   * searches (`memchr`/`memmem`), only running the automaton at candidate positions.
+   */
+  class regex_prefilter
+  {
+
+    /* -- Constants -- */
+
+  public:
+
+    /** Value returned when there is no candidate position. */
+    static const std::size_t npos;
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_prefilter` which does not filter anything. */
+    regex_prefilter()
+      : m_prefix(),
+        m_required()
+    { }
+
+    /** Constructs a new `lexer::regex_prefilter` instance with the specified literals. */
+    regex_prefilter(std::string prefix, std::string required)
+      : m_prefix(std::move(prefix)),
+        m_required(std::move(required))
+    { }
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the literal string which every match starts with. */
+    const std::string& prefix() const
+    {
+      return m_prefix;
+    }
+
+    /** Returns a literal string which every match contains. */
+    const std::string& required() const
+    {
+      return m_required;
+    }
+
+    /**
+     * Returns the first position at or after `pos` at which a match could start, based on the
+     * prefix, or `npos` if there is none.
+     */
+    std::size_t find_prefix(const char* data, std::size_t size, std::size_t pos) const;
+
+    /**
+     * Returns the first position at or after `pos` at which the required string occurs, or `npos`
+     * if there is none. If this returns `npos`, no match can start at or after `pos`.
+     */
+    std::size_t find_required(const char* data, std::size_t size, std::size_t pos) const;
+
+    /**
+     * Calls `match` with each position in the specified range at which a match could start, until
+     * it returns `true`. Returns `true` if it did.
+     */
+    template <typename match_fn>
+    bool search(const char* begin, const char* end, match_fn match) const
+    {
+      auto size = static_cast<std::size_t>(end - begin);
+
+      // position of the next occurrence of the required string, which is only updated once we
+      // have moved past it, so that the input is scanned for it at most once
+      auto required_pos = find_required(begin, size, 0);
+
+      for (auto pos = find_prefix(begin, size, 0);
+           pos != npos;
+           pos = find_prefix(begin, size, pos + 1))
+      {
+        if (required_pos != npos && required_pos < pos)
+          required_pos = find_required(begin, size, pos);
+        if (required_pos == npos)
+          return false;
+
+        if (match(begin + pos))
+          return true;
+      }
+
+      return false;
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    std::string m_prefix;
+    std::string m_required;
+
+  };
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Extracts the literal prefix and the longest required literal substring from a regular
+   * expression in postfix notation.
+   */
+  lexer::regex_prefilter postfix_to_prefilter(const std::string& postfix);
+
+  /**
+   * Extracts the literal prefix and the longest required literal substring from a regular
+   * expression.
+   */
+  lexer::regex_prefilter regex_to_prefilter(const std::string& regex);
+
+  /**
+   * Check if a match for the DFA starts anywhere in the specified range, using the prefilter to
+   * skip positions where no match can start.
+   */
+  bool regex_search(const lexer::regex_dfa& dfa,
+                    const lexer::regex_prefilter& prefilter,
+                    const char* begin,
+                    const char* end);
+
+  /**
+   * Check if a match for a regular expression starts anywhere in a string.
+   */
+  bool regex_search(const std::string& regex, const std::string& str);
+
+}
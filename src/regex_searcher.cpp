@@ -0,0 +1,86 @@
+/**
+ * @file	regex_searcher.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/23
+ */
+
+/* -- Includes -- */
+
+#include <string>
+
+#include "regex_dfa.hpp"
+#include "regex_nfa.hpp"
+#include "regex_pike_vm.hpp"
+#include "regex_searcher.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns the DFA for the reverse of an NFA. */
+  regex_dfa reverse_dfa(const regex_nfa& nfa)
+  {
+    auto reversed = reverse_nfa(nfa);
+    return nfa_to_dfa({ &reversed });
+  }
+
+}
+
+/* -- Procedures -- */
+
+regex_searcher::regex_searcher(const regex_nfa& nfa)
+  : m_forward(nfa_to_search_dfa(nfa)),
+    m_reverse(reverse_dfa(nfa))
+{
+}
+
+bool regex_searcher::search(const char* begin, const char* end, regex_submatch& match) const
+{
+  // forward scan - the end of the match is the last accepting state before the dead state
+  const char* match_end = nullptr;
+  auto state = m_forward.start();
+  if (m_forward.tag(state) != regex_dfa::no_tag)
+    match_end = begin;
+  for (auto it = begin; it != end; it++)
+  {
+    state = m_forward.next(state, static_cast<unsigned char>(*it));
+    if (m_forward.is_dead(state))
+      break;
+    if (m_forward.tag(state) != regex_dfa::no_tag)
+      match_end = it + 1;
+  }
+  if (!match_end)
+    return false;
+
+  // backward scan - the start of the match is the last accepting state before the dead state
+  const char* match_begin = match_end;
+  state = m_reverse.start();
+  for (auto it = match_end; it != begin; )
+  {
+    state = m_reverse.next(state, static_cast<unsigned char>(*--it));
+    if (m_reverse.is_dead(state))
+      break;
+    if (m_reverse.tag(state) != regex_dfa::no_tag)
+      match_begin = it;
+  }
+
+  match.begin = static_cast<size_t>(match_begin - begin);
+  match.end = static_cast<size_t>(match_end - begin);
+  return true;
+}
+
+bool regex_searcher::search(const string& str, regex_submatch& match) const
+{
+  return search(str.data(), str.data() + str.size(), match);
+}
+
+bool lexer::regex_search(const string& regex, const string& str, regex_submatch& match)
+{
+  return regex_searcher(regex_to_nfa(regex)).search(str, match);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file	regex_searcher.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/23
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <string>
+
+#include "regex_dfa.hpp"
+#include "regex_nfa.hpp"
+#include "regex_pike_vm.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class which finds the position of the leftmost-first match of an NFA in a string, using only
+   * DFAs.
+   *
+   * A forward scan with the search DFA (see `lexer::nfa_to_search_dfa`) finds where the match
+   * ends, but not where it starts, since the DFA does not know which of its threads matched.
+   * A second, backward scan from the end of the match with the DFA for the reversed NFA (see
+   * `lexer::reverse_nfa`) then finds the start: it is the leftmost position from which the
+   * reversed NFA matches, since no match could start any further left.
+   *
+   * @note
+   * A `lexer::regex_searcher` is immutable once constructed, and may be used by several threads.
+   */
+  class regex_searcher
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_searcher` instance for the specified NFA. */
+    regex_searcher(const lexer::regex_nfa& nfa);
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the DFA used to find the end of the match. */
+    const lexer::regex_dfa& forward() const
+    {
+      return m_forward;
+    }
+
+    /** Returns the DFA used to find the start of the match. */
+    const lexer::regex_dfa& reverse() const
+    {
+      return m_reverse;
+    }
+
+    /**
+     * Finds the leftmost-first match in the specified range, returning `true` and setting `match`
+     * to the offsets of the match if there is one.
+     */
+    bool search(const char* begin, const char* end, lexer::regex_submatch& match) const;
+
+    /** Finds the leftmost-first match in a string. */
+    bool search(const std::string& str, lexer::regex_submatch& match) const;
+
+    /* -- Implementation -- */
+
+  private:
+
+    lexer::regex_dfa m_forward;
+    lexer::regex_dfa m_reverse;
+
+  };
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Finds the leftmost-first match of a regular expression in a string.
+   */
+  bool regex_search(const std::string& regex, const std::string& str, lexer::regex_submatch& match);
+
+}
@@ -0,0 +1,123 @@
+/**
+ * @file	regex_set.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/14
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "regex_ast.hpp"
+#include "regex_nfa.hpp"
+#include "regex_options.hpp"
+#include "regex_set.hpp"
+#include "regex_sparse_set.hpp"
+#include "regex_utf8.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Procedures -- */
+
+regex_set::regex_set(const vector<string>& regexes, const regex_options& options)
+  : m_size(regexes.size()),
+    m_nfa(),
+    m_owners()
+{
+  if (regexes.empty())
+    return;
+
+  vector<unique_ptr<regex_nfa_fragment>> fragments;
+  vector<regex_nfa_fragment*> heads;
+
+  // copy each pattern's fragments into the combined NFA, remembering which pattern owns them
+  for (size_t id = 0; id < regexes.size(); id++)
+  {
+    const auto& regex = regexes[id];
+    auto nfa = postfix_to_nfa(
+      regex_to_simplified_postfix(options.utf8 ? regex_utf8_to_bytes(regex) : regex), options);
+    auto offset = fragments.size();
+
+    for (const auto& frag : nfa.fragments())
+    {
+      fragments.push_back(regex_nfa_fragment::create_copy(*frag));
+      m_owners.push_back(id);
+    }
+    for (const auto& frag : nfa.fragments())
+    {
+      auto* copy = fragments[offset + frag->index].get();
+      if (frag->link1.output)
+        copy->link1.output = fragments[offset + frag->link1.output->index].get();
+      if (frag->link2.output)
+        copy->link2.output = fragments[offset + frag->link2.output->index].get();
+    }
+
+    heads.push_back(fragments[offset + nfa.head()->index].get());
+  }
+
+  // join the patterns with a chain of epsilon fragments, so that each is tried in turn
+  auto* head = heads.back();
+  for (size_t id = heads.size() - 1; id-- > 0; )
+  {
+    auto frag = regex_nfa_fragment::create_epsilon();
+    frag->link1.output = heads[id];
+    frag->link2.output = head;
+    head = frag.get();
+    fragments.push_back(move(frag));
+    m_owners.push_back(id);
+  }
+
+  m_nfa = make_unique<const regex_nfa>(move(fragments), head);
+}
+
+vector<bool> regex_set::match(const string& str) const
+{
+  vector<bool> matched(m_size, false);
+  if (!m_nfa)
+    return matched;
+
+  const auto& fragments = m_nfa->fragments();
+  auto remaining = m_size;
+  regex_sparse_set current(fragments.size());
+  regex_sparse_set next(fragments.size());
+  regex_nfa_closure closure(*m_nfa);
+
+  // local procedure to enter a fragment, adding its closure to a set of live fragments
+  auto add = [&] (regex_sparse_set& set, const regex_nfa_fragment* frag) {
+    closure.add(frag, [&] (size_t index) {
+        set.insert(index);
+        if (fragments[index]->is_terminal() && !matched[m_owners[index]])
+        {
+          matched[m_owners[index]] = true;
+          remaining--;
+        }
+      });
+  };
+
+  add(current, m_nfa->head());
+  for (auto ch : str)
+  {
+    if (current.empty() || remaining == 0)
+      break;
+
+    next.clear();
+    closure.clear();
+    for (auto index : current)
+    {
+      // once a pattern has matched, there is no need to keep following it
+      const auto* frag = fragments[index].get();
+      if (frag->is_symbol() &&
+          !matched[m_owners[index]] &&
+          frag->link1.matches(static_cast<unsigned char>(ch)))
+        add(next, frag->link1.output);
+    }
+    swap(current, next);
+  }
+
+  return matched;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file	regex_set.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/14
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "regex_nfa.hpp"
+#include "regex_options.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing a set of regular expressions which are matched simultaneously.
+   *
+   * The NFAs for all of the patterns are joined under a single start state, and each pattern's
+   * terminal fragment is tagged with the pattern's index. Matching a string then takes one pass
+   * over the input, regardless of the number of patterns.
+   *
+   * @note
+   * A `lexer::regex_set` is immutable once constructed, and may be used by several threads.
+   */
+  class regex_set
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_set` instance for the specified regular expressions. */
+    regex_set(const std::vector<std::string>& regexes,
+              const lexer::regex_options& options = lexer::regex_options());
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the number of patterns in this set. */
+    std::size_t size() const
+    {
+      return m_size;
+    }
+
+    /** Returns the combined NFA for all of the patterns, or `nullptr` if the set is empty. */
+    const lexer::regex_nfa* nfa() const
+    {
+      return m_nfa.get();
+    }
+
+    /** Returns the index of the pattern owning the specified fragment of the combined NFA. */
+    std::size_t owner(std::size_t fragment_index) const
+    {
+      return m_owners[fragment_index];
+    }
+
+    /**
+     * Returns a bitset indicating which patterns match the specified string.
+     *
+     * Bit `n` of the result is set if `lexer::regex_match` would return `true` for pattern `n`.
+     */
+    std::vector<bool> match(const std::string& str) const;
+
+    /* -- Implementation -- */
+
+  private:
+
+    std::size_t m_size;
+    std::unique_ptr<const lexer::regex_nfa> m_nfa;
+    std::vector<std::size_t> m_owners;
+
+  };
+
+}
@@ -0,0 +1,102 @@
+/**
+ * @file	regex_sparse_set.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/14
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <vector>
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing a set of NFA fragment indices, used to track live states while simulating
+   * an NFA.
+   *
+   * @note
+   * This is the sparse set described at https://research.swtch.com/sparse. Insertion, lookup and
+   * clearing are all constant time, and iteration follows insertion order.
+   */
+  class regex_sparse_set
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::regex_sparse_set` for indices less than `capacity`. */
+    regex_sparse_set(std::size_t capacity)
+      : m_dense(capacity),
+        m_sparse(capacity),
+        m_size(0)
+    { }
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns `true` if the set contains the specified index. */
+    bool contains(std::size_t index) const
+    {
+      auto position = m_sparse[index];
+      return (position < m_size && m_dense[position] == index);
+    }
+
+    /** Adds an index to the set, returning `false` if it was already present. */
+    bool insert(std::size_t index)
+    {
+      if (contains(index))
+        return false;
+      m_sparse[index] = m_size;
+      m_dense[m_size++] = index;
+      return true;
+    }
+
+    /** Removes all indices from the set. */
+    void clear()
+    {
+      m_size = 0;
+    }
+
+    /** Returns `true` if the set is empty. */
+    bool empty() const
+    {
+      return (m_size == 0);
+    }
+
+    /** Returns the number of indices in the set. */
+    std::size_t size() const
+    {
+      return m_size;
+    }
+
+    /** Returns an iterator to the first index in the set. */
+    std::vector<std::size_t>::const_iterator begin() const
+    {
+      return m_dense.cbegin();
+    }
+
+    /** Returns an iterator past the last index in the set. */
+    std::vector<std::size_t>::const_iterator end() const
+    {
+      return m_dense.cbegin() + m_size;
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    std::vector<std::size_t> m_dense;
+    std::vector<std::size_t> m_sparse;
+    std::size_t m_size;
+
+  };
+
+}
@@ -0,0 +1,474 @@
+/**
+ * @file	regex_utf8.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/22
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "diagnostic.hpp"
+#include "regex_charset.hpp"
+#include "regex_constants.hpp"
+#include "regex_postfix.hpp"
+#include "regex_utf8.hpp"
+#include "result.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Constants -- */
+
+namespace
+{
+
+  /** The highest Unicode code point. */
+  const uint32_t max_code_point = 0x10ffff;
+
+  /** The first surrogate code point. */
+  const uint32_t min_surrogate = 0xd800;
+
+  /** The last surrogate code point. */
+  const uint32_t max_surrogate = 0xdfff;
+
+  /** The highest code point encoded with each number of bytes. */
+  const uint32_t max_encoded[] = { 0x7f, 0x7ff, 0xffff };
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns a diagnostic for a malformed atom at the specified position. */
+  diagnostic utf8_error(diagnostic_kind kind, size_t pos)
+  {
+    return { kind, pos, 1, 0, static_cast<int>(pos) };
+  }
+
+  /** Writes the UTF-8 encoding of a code point, returning the number of bytes. */
+  size_t encode(uint32_t cp, unsigned char* bytes)
+  {
+    if (cp <= 0x7f)
+    {
+      bytes[0] = static_cast<unsigned char>(cp);
+      return 1;
+    }
+    if (cp <= 0x7ff)
+    {
+      bytes[0] = static_cast<unsigned char>(0xc0 | (cp >> 6));
+      bytes[1] = static_cast<unsigned char>(0x80 | (cp & 0x3f));
+      return 2;
+    }
+    if (cp <= 0xffff)
+    {
+      bytes[0] = static_cast<unsigned char>(0xe0 | (cp >> 12));
+      bytes[1] = static_cast<unsigned char>(0x80 | ((cp >> 6) & 0x3f));
+      bytes[2] = static_cast<unsigned char>(0x80 | (cp & 0x3f));
+      return 3;
+    }
+    bytes[0] = static_cast<unsigned char>(0xf0 | (cp >> 18));
+    bytes[1] = static_cast<unsigned char>(0x80 | ((cp >> 12) & 0x3f));
+    bytes[2] = static_cast<unsigned char>(0x80 | ((cp >> 6) & 0x3f));
+    bytes[3] = static_cast<unsigned char>(0x80 | (cp & 0x3f));
+    return 4;
+  }
+
+  /** Decodes the UTF-8 encoded code point at the specified position. */
+  result<uint32_t> decode(const string& str, size_t pos, size_t& length)
+  {
+    auto lead = static_cast<unsigned char>(str[pos]);
+    uint32_t cp = 0;
+    uint32_t min = 0;
+    if (lead < 0x80)
+    {
+      length = 1;
+      return lead;
+    }
+    else if ((lead & 0xe0) == 0xc0)
+    {
+      length = 2;
+      cp = lead & 0x1f;
+      min = 0x80;
+    }
+    else if ((lead & 0xf0) == 0xe0)
+    {
+      length = 3;
+      cp = lead & 0x0f;
+      min = 0x800;
+    }
+    else if ((lead & 0xf8) == 0xf0)
+    {
+      length = 4;
+      cp = lead & 0x07;
+      min = 0x10000;
+    }
+    else
+      return utf8_error(diagnostic_kind::regex_invalid_utf8, pos);
+
+    if (pos + length > str.size())
+      return utf8_error(diagnostic_kind::regex_invalid_utf8, pos);
+    for (size_t idx = 1; idx < length; idx++)
+    {
+      auto ch = static_cast<unsigned char>(str[pos + idx]);
+      if ((ch & 0xc0) != 0x80)
+        return utf8_error(diagnostic_kind::regex_invalid_utf8, pos);
+      cp = (cp << 6) | (ch & 0x3f);
+    }
+
+    // overlong encodings, surrogates and values beyond the Unicode range are all invalid
+    if (cp < min || cp > max_code_point || (cp >= min_surrogate && cp <= max_surrogate))
+      return utf8_error(diagnostic_kind::regex_invalid_utf8, pos);
+    return cp;
+  }
+
+  /** Returns a set containing all bytes in the specified inclusive range. */
+  regex_charset byte_range(unsigned char low, unsigned char high)
+  {
+    regex_charset set;
+    for (unsigned ch = low; ch <= high; ch++)
+      set.set(ch);
+    return set;
+  }
+
+  /** Appends the sequences for a range of code points which all have the same encoded length. */
+  void append_sequences(vector<regex_utf8_sequence>& sequences, uint32_t low, uint32_t high)
+  {
+    // split the range wherever a continuation byte would wrap around, so that each byte of the
+    // encodings covers a single range of values - e.g. U+0800 to U+0FFF is [\xe0][\xa0-\xbf][\x80-\xbf]
+    for (uint32_t shift = 6; shift <= 18; shift += 6)
+    {
+      uint32_t mask = (1u << shift) - 1;
+      if ((low & ~mask) == (high & ~mask))
+        continue;
+      if ((low & mask) != 0)
+      {
+        append_sequences(sequences, low, low | mask);
+        append_sequences(sequences, (low | mask) + 1, high);
+        return;
+      }
+      if ((high & mask) != mask)
+      {
+        append_sequences(sequences, low, (high & ~mask) - 1);
+        append_sequences(sequences, high & ~mask, high);
+        return;
+      }
+    }
+
+    unsigned char low_bytes[4];
+    unsigned char high_bytes[4];
+    auto length = encode(low, low_bytes);
+    encode(high, high_bytes);
+
+    regex_utf8_sequence sequence;
+    for (size_t idx = 0; idx < length; idx++)
+      sequence.push_back(byte_range(low_bytes[idx], high_bytes[idx]));
+    sequences.push_back(sequence);
+  }
+
+  /** Returns the code points matched by an escape in a class or on its own. */
+  result<vector<regex_code_point_range>> escape_ranges(const string& regex,
+                                                       size_t pos,
+                                                       size_t& length)
+  {
+    auto atom = try_regex_atom_charset(regex, pos, length);
+    if (!atom)
+      return atom.error();
+    const auto& set = atom.value();
+    vector<regex_code_point_range> ranges;
+
+    // single characters (including `\xHH`) are code points - otherwise, the set is an ASCII class
+    // (`\d`, `\w` etc.), and the negated classes contain every non-ASCII code point too
+    if (set.count() == 1)
+    {
+      uint32_t cp = 0;
+      while (!set.test(cp))
+        cp++;
+      ranges.push_back({ cp, cp });
+      return ranges;
+    }
+    for (uint32_t cp = 0; cp < 0x80; cp++)
+    {
+      if (set.test(cp))
+        ranges.push_back({ cp, cp });
+    }
+    if (set.test(0x80))
+      ranges.push_back({ 0x80, max_code_point });
+    return ranges;
+  }
+
+  /** Returns the code point range for a single (non-range) element of a character class. */
+  result<vector<regex_code_point_range>> class_element(const string& regex,
+                                                       size_t pos,
+                                                       size_t& length)
+  {
+    if (regex[pos] == regex_constants::escape)
+      return escape_ranges(regex, pos, length);
+    auto cp = decode(regex, pos, length);
+    if (!cp)
+      return cp.error();
+    return vector<regex_code_point_range> { { cp.value(), cp.value() } };
+  }
+
+  /** Returns every code point not in the specified (sorted, merged) ranges. */
+  vector<regex_code_point_range> complement(const vector<regex_code_point_range>& ranges)
+  {
+    vector<regex_code_point_range> result;
+    uint32_t next = 0;
+    for (const auto& range : ranges)
+    {
+      if (range.low > next)
+        result.push_back({ next, range.low - 1 });
+      next = range.high + 1;
+    }
+    if (next <= max_code_point)
+      result.push_back({ next, max_code_point });
+    return result;
+  }
+
+  /** Sorts ranges and merges any which overlap or touch. */
+  vector<regex_code_point_range> normalize(vector<regex_code_point_range> ranges)
+  {
+    sort(ranges.begin(), ranges.end(), [] (const auto& range1, const auto& range2) {
+        return range1.low < range2.low;
+      });
+
+    vector<regex_code_point_range> result;
+    for (const auto& range : ranges)
+    {
+      if (!result.empty() && range.low <= result.back().high + 1)
+        result.back().high = max(result.back().high, range.high);
+      else
+        result.push_back(range);
+    }
+    return result;
+  }
+
+  /** Parses a character class, returning its code point ranges. */
+  result<vector<regex_code_point_range>> parse_class(const string& regex,
+                                                     size_t pos,
+                                                     size_t& length)
+  {
+    vector<regex_code_point_range> ranges;
+    size_t idx = pos + 1;
+
+    bool negate = (idx < regex.size() && regex[idx] == regex_constants::negate_class);
+    if (negate)
+      idx++;
+
+    // a close bracket is literal if it is the first character in the class
+    bool first = true;
+    while (true)
+    {
+      if (idx >= regex.size())
+        return utf8_error(diagnostic_kind::regex_unterminated_class, pos);
+      if (regex[idx] == regex_constants::close_class && !first)
+        break;
+      first = false;
+
+      size_t element_length = 0;
+      auto parsed = class_element(regex, idx, element_length);
+      if (!parsed)
+        return parsed.error();
+      auto& element = parsed.value();
+      idx += element_length;
+
+      // check for a range, unless the separator is the last character in the class
+      if (idx + 1 < regex.size() &&
+          regex[idx] == regex_constants::class_range &&
+          regex[idx + 1] != regex_constants::close_class)
+      {
+        size_t high_length = 0;
+        auto parsed_high = class_element(regex, idx + 1, high_length);
+        if (!parsed_high)
+          return parsed_high.error();
+        const auto& high = parsed_high.value();
+        if (element.size() != 1 || high.size() != 1 ||
+            element[0].low != element[0].high || high[0].low != high[0].high ||
+            element[0].low > high[0].low)
+          return utf8_error(diagnostic_kind::regex_invalid_class_range, idx);
+        element = { { element[0].low, high[0].low } };
+        idx += 1 + high_length;
+      }
+
+      ranges.insert(ranges.end(), element.begin(), element.end());
+    }
+
+    length = idx + 1 - pos;
+    return (negate ? complement(normalize(ranges)) : ranges);
+  }
+
+  /** Appends the regular expression for a sequence of byte sets. */
+  void append_sequence(string& result, const regex_utf8_sequence& sequence)
+  {
+    for (const auto& set : sequence)
+      result += regex_charset_atom(set);
+  }
+
+}
+
+/* -- Procedures -- */
+
+vector<regex_utf8_sequence> lexer::utf8_sequences(vector<regex_code_point_range> ranges)
+{
+  vector<regex_utf8_sequence> sequences;
+  for (auto range : normalize(move(ranges)))
+  {
+    // split wherever the encoded length changes, skipping the surrogates (which have no encoding)
+    vector<regex_code_point_range> pieces;
+    for (auto low = range.low; low <= range.high; )
+    {
+      if (low >= min_surrogate && low <= max_surrogate)
+      {
+        low = max_surrogate + 1;
+        continue;
+      }
+
+      auto high = range.high;
+      if (low < min_surrogate)
+        high = min(high, min_surrogate - 1);
+      for (auto max : max_encoded)
+      {
+        if (low <= max)
+        {
+          high = min(high, max);
+          break;
+        }
+      }
+      pieces.push_back({ low, high });
+      low = high + 1;
+    }
+
+    for (const auto& piece : pieces)
+      append_sequences(sequences, piece.low, piece.high);
+  }
+
+  // merge all single byte sequences into the first one
+  vector<regex_utf8_sequence> result;
+  size_t single = 0;
+  bool has_single = false;
+  for (auto& sequence : sequences)
+  {
+    if (sequence.size() == 1 && has_single)
+    {
+      result[single][0] |= sequence[0];
+      continue;
+    }
+    if (sequence.size() == 1)
+    {
+      single = result.size();
+      has_single = true;
+    }
+    result.push_back(move(sequence));
+  }
+  return result;
+}
+
+vector<regex_utf8_sequence> lexer::regex_utf8_atom(const string& regex, size_t pos, size_t& length)
+{
+  auto sequences = try_regex_utf8_atom(regex, pos, length);
+  if (!sequences)
+    throw runtime_error(diagnostic_message(sequences.error(), regex));
+  return move(sequences.value());
+}
+
+result<vector<regex_utf8_sequence>> lexer::try_regex_utf8_atom(const string& regex,
+                                                               size_t pos,
+                                                               size_t& length)
+{
+  vector<regex_code_point_range> ranges;
+  switch (regex[pos])
+  {
+  case regex_constants::any:
+    // any code point except newline
+    length = 1;
+    ranges = complement({ { '\n', '\n' } });
+    break;
+  case regex_constants::open_class:
+  case regex_constants::escape:
+  {
+    auto parsed = (regex[pos] == regex_constants::open_class ?
+                   parse_class(regex, pos, length) :
+                   escape_ranges(regex, pos, length));
+    if (!parsed)
+      return parsed.error();
+    ranges = move(parsed.value());
+    break;
+  }
+  default:
+  {
+    auto cp = decode(regex, pos, length);
+    if (!cp)
+      return cp.error();
+    ranges.push_back({ cp.value(), cp.value() });
+    break;
+  }
+  }
+
+  auto sequences = utf8_sequences(move(ranges));
+  if (sequences.empty())
+    return utf8_error(diagnostic_kind::regex_empty_class, pos);
+  return sequences;
+}
+
+string lexer::regex_utf8_to_bytes(const string& regex)
+{
+  string result;
+  for (size_t idx = 0; idx < regex.size(); )
+  {
+    switch (regex[idx])
+    {
+
+    case regex_constants::union_op:
+    case regex_constants::optional_op:
+    case regex_constants::kleene_op:
+    case regex_constants::repeat_op:
+    case regex_constants::open_bracket:
+    case regex_constants::close_bracket:
+      result.push_back(regex[idx++]);
+      break;
+
+    case regex_constants::open_repetition_op:
+    {
+      auto length = parse_regex_repetition(regex, idx).length;
+      result.append(regex, idx, length);
+      idx += length;
+      break;
+    }
+
+    default:
+    {
+      // atoms with more than one byte (or more than one sequence) are bracketed, so that any
+      // operator which follows them applies to the whole atom
+      size_t length = 0;
+      auto sequences = regex_utf8_atom(regex, idx, length);
+      idx += length;
+      if (sequences.size() == 1 && sequences[0].size() == 1)
+      {
+        append_sequence(result, sequences[0]);
+        break;
+      }
+
+      result.push_back(regex_constants::open_bracket);
+      for (size_t seq = 0; seq < sequences.size(); seq++)
+      {
+        if (seq > 0)
+          result.push_back(regex_constants::union_op);
+        append_sequence(result, sequences[seq]);
+      }
+      result.push_back(regex_constants::close_bracket);
+      break;
+    }
+
+    }
+  }
+  return result;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file	regex_utf8.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/22
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "regex_charset.hpp"
+#include "result.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Struct representing an inclusive range of Unicode code points.
+   */
+  struct regex_code_point_range
+  {
+
+    /** The first code point in the range. */
+    std::uint32_t low;
+
+    /** The last code point in the range. */
+    std::uint32_t high;
+
+  };
+
+  /**
+   * A sequence of byte sets, matching the UTF-8 encoding of one code point a byte at a time.
+   *
+   * For example, `{ [\xc2-\xdf], [\x80-\xbf] }` matches every two byte code point.
+   */
+  using regex_utf8_sequence = std::vector<lexer::regex_charset>;
+
+}
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Returns the byte sequences matching the UTF-8 encodings of exactly the code points in the
+   * specified ranges (less any surrogates, which cannot be encoded).
+   *
+   * Each range is split wherever the length of the encoding changes, and then wherever a
+   * continuation byte wraps around, until every byte of the encodings in each piece covers a
+   * single range of values. This is the technique used by RE2 and Rust's regex crate, and means
+   * that a class such as `[α-ω]` costs a handful of byte transitions rather than a decoding step.
+   * Single byte sequences are merged into one, so that ASCII ranges stay a single set.
+   */
+  std::vector<lexer::regex_utf8_sequence> utf8_sequences(
+    std::vector<lexer::regex_code_point_range> ranges);
+
+  /**
+   * Parses the atom at the specified position of a UTF-8 regular expression, returning the byte
+   * sequences it matches and setting `length` to the number of bytes it takes up.
+   *
+   * Literal characters may be any UTF-8 encoded code point, and the wildcard and character classes
+   * (including negated ones) match whole code points. Escapes are as for `lexer::regex_atom_charset`,
+   * with `\xHH` meaning the code point `U+00HH`.
+   *
+   * @exception std::runtime_error
+   * Thrown if the atom is invalid, including if it is not valid UTF-8.
+   */
+  std::vector<lexer::regex_utf8_sequence> regex_utf8_atom(const std::string& regex,
+                                                          std::size_t pos,
+                                                          std::size_t& length);
+
+  /**
+   * Parses the atom at the specified position of a UTF-8 regular expression like
+   * `lexer::regex_utf8_atom`, but returns a diagnostic rather than throwing if it is invalid.
+   */
+  lexer::result<std::vector<lexer::regex_utf8_sequence>> try_regex_utf8_atom(
+    const std::string& regex,
+    std::size_t pos,
+    std::size_t& length);
+
+  /**
+   * Rewrites a UTF-8 regular expression into an equivalent regular expression over bytes, in which
+   * every atom is replaced by the alternation of its byte sequences.
+   *
+   * This lets the byte-level engines (postfix notation, syntax trees, DFAs, etc.) handle UTF-8
+   * without any changes, and without decoding anything while matching.
+   */
+  std::string regex_utf8_to_bytes(const std::string& regex);
+
+}
@@ -0,0 +1,165 @@
+/**
+ * @file	result.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/25
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "diagnostic.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class holding either a value or the `lexer::diagnostic` describing why there is no value.
+   *
+   * This is the return type of the non-throwing (`try_`) variants of the lexing and parsing
+   * procedures, for callers which see invalid input often enough that throwing and formatting an
+   * exception for each one is too expensive.
+   */
+  template <typename T>
+  class result
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::result` holding the specified value. */
+    result(T value)
+      : m_ok(true),
+        m_error()
+    {
+      new (&m_storage) T(std::move(value));
+    }
+
+    /** Constructs a new `lexer::result` holding the specified error. */
+    result(const lexer::diagnostic& error)
+      : m_ok(false),
+        m_error(error)
+    { }
+
+    /** Move constructor. */
+    result(result&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+      : m_ok(other.m_ok),
+        m_error(other.m_error)
+    {
+      if (m_ok)
+        new (&m_storage) T(std::move(other.get()));
+    }
+
+    /**
+     * Move assignment operator. If moving the value throws, this result is left holding what it
+     * held before (or, if both held values, whatever the value's own move assignment leaves).
+     */
+    result& operator=(result&& other) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                               std::is_nothrow_move_assignable<T>::value)
+    {
+      if (this == &other)
+        return *this;
+
+      if (m_ok && other.m_ok)
+        get() = std::move(other.get());
+      else if (m_ok)
+      {
+        get().~T();
+        m_ok = false;
+      }
+      else if (other.m_ok)
+      {
+        new (&m_storage) T(std::move(other.get()));
+        m_ok = true;
+      }
+      m_error = other.m_error;
+      return *this;
+    }
+
+    result(const result&) = delete;
+    result& operator=(const result&) = delete;
+
+    /** Destructor. */
+    ~result()
+    {
+      if (m_ok)
+        get().~T();
+    }
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns `true` if this result holds a value. */
+    bool ok() const
+    {
+      return m_ok;
+    }
+
+    /** Returns `true` if this result holds a value. */
+    explicit operator bool() const
+    {
+      return m_ok;
+    }
+
+    /**
+     * Returns the value.
+     *
+     * @exception std::logic_error
+     * Thrown if this result holds an error.
+     */
+    T& value()
+    {
+      if (!m_ok)
+        throw std::logic_error("Result holds an error!");
+      return get();
+    }
+
+    /**
+     * Returns the value.
+     *
+     * @exception std::logic_error
+     * Thrown if this result holds an error.
+     */
+    const T& value() const
+    {
+      if (!m_ok)
+        throw std::logic_error("Result holds an error!");
+      return get();
+    }
+
+    /** Returns the error. This is only meaningful if the result does not hold a value. */
+    const lexer::diagnostic& error() const
+    {
+      return m_error;
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    T& get()
+    {
+      return *reinterpret_cast<T*>(&m_storage);
+    }
+
+    const T& get() const
+    {
+      return *reinterpret_cast<const T*>(&m_storage);
+    }
+
+    bool m_ok;
+    lexer::diagnostic m_error;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;
+
+  };
+
+}
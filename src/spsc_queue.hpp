@@ -0,0 +1,98 @@
+/**
+ * @file	spsc_queue.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/22
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing a bounded queue between exactly one producer thread and exactly one
+   * consumer thread.
+   *
+   * @note
+   * The queue is a ring buffer with no locks: the producer only writes the tail index and the
+   * consumer only writes the head index, and each is kept on its own cache line. A full queue
+   * makes `try_push` fail, which is how a slow consumer pushes back on its producer.
+   */
+  template <typename T>
+  class spsc_queue
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Constructs a new `lexer::spsc_queue` holding at most `capacity` items. */
+    spsc_queue(std::size_t capacity)
+      : m_items(capacity + 1),
+        m_head(0),
+        m_tail(0)
+    { }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the maximum number of items in the queue. */
+    std::size_t capacity() const
+    {
+      return m_items.size() - 1;
+    }
+
+    /** Adds an item to the back of the queue. Returns `false` if the queue is full. */
+    bool try_push(T& item)
+    {
+      auto tail = m_tail.load(std::memory_order_relaxed);
+      auto next = advance(tail);
+      if (next == m_head.load(std::memory_order_acquire))
+        return false;
+
+      m_items[tail] = std::move(item);
+      m_tail.store(next, std::memory_order_release);
+      return true;
+    }
+
+    /** Removes the item at the front of the queue. Returns `false` if the queue is empty. */
+    bool try_pop(T& item)
+    {
+      auto head = m_head.load(std::memory_order_relaxed);
+      if (head == m_tail.load(std::memory_order_acquire))
+        return false;
+
+      item = std::move(m_items[head]);
+      m_head.store(advance(head), std::memory_order_release);
+      return true;
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    std::size_t advance(std::size_t index) const
+    {
+      return (index + 1 == m_items.size() ? 0 : index + 1);
+    }
+
+    std::vector<T> m_items;
+    alignas(64) std::atomic<std::size_t> m_head;
+    alignas(64) std::atomic<std::size_t> m_tail;
+
+  };
+
+}
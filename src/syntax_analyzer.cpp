@@ -7,69 +7,146 @@
 /* -- Includes -- */
 
 #include <cassert>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <sstream>
+#include <vector>
 
+#include "diagnostic.hpp"
 #include "expression.hpp"
 #include "lexical_analyzer.hpp"
+#include "result.hpp"
 #include "syntax_analyzer.hpp"
 #include "token.hpp"
+#include "token_stream.hpp"
 
 /* -- Namespaces -- */
 
 using namespace std;
 using namespace lexer;
 
-/* -- Types -- */
+/* -- Private Procedures -- */
 
-struct syntax_analyzer::implementation
+namespace
 {
 
-  /* -- Constructor -- */
-
-  implementation(lexical_analyzer& lex)
-    : lex(lex)
-  { }
-
-  /* -- Fields -- */
-
-  lexical_analyzer& lex;
-
-  /* -- Procedures -- */
-
-  /** Gets an operator type from the specified token. */
-  static operator_type get_operator_type(const token& tok)
+  /** Gets an operator type from the specified token. Returns `false` if it is not an operator. */
+  bool get_operator_type(const token& tok, operator_type& op)
   {
     if (tok.type() != token_type::op)
-      throw parse_error(tok);
+      return false;
 
     if (tok.lexeme() == "+")
-      return operator_type::addition;
+      op = operator_type::addition;
     else if (tok.lexeme() == "-")
-      return operator_type::subtraction;
+      op = operator_type::subtraction;
     else if (tok.lexeme() == "*")
-      return operator_type::multiplication;
+      op = operator_type::multiplication;
     else if (tok.lexeme() == "/")
-      return operator_type::division;
+      op = operator_type::division;
     else
-      throw parse_error(tok);
+      return false;
+
+    return true;
   }
 
-  /** Gets an integer value from the specified token. */
-  static int get_value(const token& tok)
+  /**
+   * Parses the next expression, reading tokens from the specified function.
+   *
+   * Returns `false` if the tokens do not form a valid expression, setting `error` to the token to
+   * blame, rather than throwing, so that callers which recover from errors do not pay for an
+   * exception each time.
+   */
+  template <typename next_token_fn>
+  bool parse(next_token_fn& next_token, unique_ptr<const expression>& result, token& error)
   {
-    if (tok.type() != token_type::number)
-      throw parse_error(tok);
+    token tok = next_token();
+    if (tok.type() == token_type::eof)
+    {
+      // nothing left in input stream
+      result = nullptr;
+      return true;
+    }
+    else if (tok.type() == token_type::number)
+    {
+      // simple expression
+      int value = 0;
+      if (!token_value(tok, value))
+      {
+        error = move(tok);
+        return false;
+      }
+      result = make_unique<simple_expression>(value);
+      return true;
+    }
+    else if (tok.type() == token_type::open_bracket)
+    {
+      // get contents
+      unique_ptr<const expression> left;
+      if (!parse(next_token, left, error))
+        return false;
+
+      operator_type op;
+      token op_tok = next_token();
+      if (!get_operator_type(op_tok, op))
+      {
+        error = move(op_tok);
+        return false;
+      }
+
+      unique_ptr<const expression> right;
+      if (!parse(next_token, right, error))
+        return false;
+
+      // verify closing bracket
+      if (next_token().type() != token_type::close_bracket)
+      {
+        error = move(tok);
+        return false;
+      }
 
-    int value = 0;
-    istringstream stream(tok.lexeme());
-    if (!(stream >> value))
-      throw parse_error(tok);
+      result = make_unique<compound_expression>(op, move(left), move(right));
+      return true;
+    }
+    else
+    {
+      // unknown???
+      error = move(tok);
+      return false;
+    }
+  }
 
-    return value;
+  /** Parses the next expression, reading tokens from the specified function. */
+  template <typename next_token_fn>
+  unique_ptr<const expression> parse(next_token_fn& next_token)
+  {
+    unique_ptr<const expression> result;
+    token error;
+    if (!parse(next_token, result, error))
+      throw parse_error(error);
+    return result;
   }
 
+}
+
+/* -- Types -- */
+
+struct syntax_analyzer::implementation
+{
+
+  /* -- Constructor -- */
+
+  implementation(lexical_analyzer& lex, vector<diagnostic>* diagnostics)
+    : tokens(lex),
+      diagnostics(diagnostics)
+  { }
+
+  /* -- Fields -- */
+
+  token_stream tokens;
+  vector<diagnostic>* diagnostics;
+
 };
 
 /* -- Procedures -- */
@@ -84,7 +161,12 @@ parse_error::parse_error(const string& lexeme, int line_number, int column_numbe
 }
 
 syntax_analyzer::syntax_analyzer(lexical_analyzer& lex)
-  : impl(make_unique<implementation>(lex))
+  : impl(make_unique<implementation>(lex, nullptr))
+{
+}
+
+syntax_analyzer::syntax_analyzer(lexical_analyzer& lex, vector<diagnostic>& diagnostics)
+  : impl(make_unique<implementation>(lex, &diagnostics))
 {
 }
 
@@ -92,33 +174,104 @@ syntax_analyzer::~syntax_analyzer() = default;
 
 unique_ptr<const expression> syntax_analyzer::next_expression()
 {
-  token tok = impl->lex.next_token();
-  if (tok.type() == token_type::eof)
-  {
-    // nothing left in input stream
-    return nullptr;
-  }
-  else if (tok.type() == token_type::number)
+  auto& tokens = impl->tokens;
+  if (!impl->diagnostics)
   {
-    // simple expression
-    return make_unique<simple_expression>(implementation::get_value(tok));
+    auto next_token = [&] () { return tokens.next(); };
+    return parse(next_token);
   }
-  else if (tok.type() == token_type::open_bracket)
+
+  while (true)
   {
-    // get contents
-    auto left = next_expression();
-    auto op = implementation::get_operator_type(impl->lex.next_token());
-    auto right = next_expression();
+    // track the bracket depth within the expression, so that we know where it ends if it fails
+    int depth = 0;
+    auto next_token = [&] () {
+      auto tok = tokens.next();
+      if (tok.type() == token_type::open_bracket)
+        depth++;
+      else if (tok.type() == token_type::close_bracket)
+        depth--;
+      return tok;
+    };
 
-    // verify closing bracket
-    if (impl->lex.next_token().type() != token_type::close_bracket)
-      throw parse_error(tok);
+    unique_ptr<const expression> result;
+    token error;
+    if (parse(next_token, result, error))
+      return result;
 
-    return make_unique<compound_expression>(op, move(left), move(right));
-  }
-  else
-  {
-    // unknown???
-    throw parse_error(tok.lexeme(), tok.line_number(), tok.column_number());
+    impl->diagnostics->push_back({ diagnostic_kind::unexpected_token,
+                                   error.offset(),
+                                   error.lexeme().size(),
+                                   error.line_number(),
+                                   error.column_number() });
+
+    // skip the rest of the failed expression, up to the next top-level open bracket
+    for (auto type = tokens.peek().type();
+         type != token_type::eof && !(type == token_type::open_bracket && depth <= 0);
+         type = tokens.peek().type())
+    {
+      next_token();
+    }
   }
 }
+
+result<unique_ptr<const expression>> syntax_analyzer::try_next_expression()
+{
+  if (impl->diagnostics)
+    return next_expression();
+
+  // an invalid token ends the input as far as the parser is concerned, and is reported instead
+  // of whatever the parser makes of that
+  auto& tokens = impl->tokens;
+  bool lex_failed = false;
+  diagnostic lex_error { };
+  auto next_token = [&] () {
+    if (!lex_failed)
+    {
+      auto tok = tokens.try_next();
+      if (tok)
+        return move(tok.value());
+      lex_failed = true;
+      lex_error = tok.error();
+    }
+    token eof;
+    eof.set_type(token_type::eof);
+    return eof;
+  };
+
+  unique_ptr<const expression> expr;
+  token error;
+  bool parsed = parse(next_token, expr, error);
+  if (lex_failed)
+    return lex_error;
+  if (!parsed)
+    return diagnostic { diagnostic_kind::unexpected_token,
+                        error.offset(),
+                        error.lexeme().size(),
+                        error.line_number(),
+                        error.column_number() };
+  return move(expr);
+}
+
+bool lexer::token_value(const token& tok, int& value)
+{
+  if (tok.type() != token_type::number)
+    return false;
+
+  istringstream stream(tok.lexeme());
+  return static_cast<bool>(stream >> value);
+}
+
+unique_ptr<const expression> lexer::parse_expression(const vector<token>& tokens, size_t& index)
+{
+  // the last token is `eof`, which is returned again if the parser tries to read past it
+  auto next_token = [&] () -> const token& {
+    return (index + 1 < tokens.size() ? tokens[index++] : tokens.back());
+  };
+  return parse(next_token);
+}
+
+unique_ptr<const expression> lexer::parse_expression(const function<token()>& next_token)
+{
+  return parse(next_token);
+}
@@ -8,11 +8,16 @@
 
 /* -- Includes -- */
 
+#include <cstddef>
 #include <exception>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "diagnostic.hpp"
 #include "lexical_analyzer.hpp"
+#include "result.hpp"
 #include "token.hpp"
 
 /* -- Types -- */
@@ -65,6 +70,16 @@ namespace lexer
     /** Constructs a new `lexer::syntax_analyzer` with the specified parameters. */
     syntax_analyzer(lexer::lexical_analyzer& lex);
 
+    /**
+     * Constructs a new `lexer::syntax_analyzer` which recovers from invalid expressions.
+     *
+     * Rather than throwing `lexer::parse_error`, the parser appends a diagnostic to `diagnostics`,
+     * skips to the next open bracket outside of the expression it was parsing, and carries on from
+     * there. To recover from invalid tokens as well, the lexer must also be constructed with a
+     * diagnostics vector.
+     */
+    syntax_analyzer(lexer::lexical_analyzer& lex, std::vector<lexer::diagnostic>& diagnostics);
+
     /** Destructor. */
     ~syntax_analyzer();
 
@@ -75,6 +90,15 @@ namespace lexer
     /** Parses the next top-level expression. */
     std::unique_ptr<const lexer::expression> next_expression();
 
+    /**
+     * Parses the next top-level expression, or returns a diagnostic rather than throwing
+     * `lexer::invalid_token_error` or `lexer::parse_error` if the input is invalid. An invalid
+     * token takes priority over the parse error it leads to.
+     *
+     * In recovery mode this is the same as `next_expression`, since nothing is thrown anyway.
+     */
+    lexer::result<std::unique_ptr<const lexer::expression>> try_next_expression();
+
     /* -- Implementation -- */
 
   private:
@@ -85,3 +109,41 @@ namespace lexer
   };
 
 }
+
+/* -- Procedure Prototypes -- */
+
+namespace lexer
+{
+
+  /**
+   * Gets the integer value of the specified token. Returns `false` if it is not a number, or its
+   * value does not fit in an `int`.
+   */
+  bool token_value(const lexer::token& tok, int& value);
+
+  /**
+   * Parses the expression starting at the specified index of a token stream, advancing the index
+   * past it. The token stream must end with an `eof` token.
+   *
+   * Returns `nullptr` if the index is at the `eof` token.
+   *
+   * @exception lexer::parse_error
+   * Thrown if the tokens do not form a valid expression.
+   */
+  std::unique_ptr<const lexer::expression> parse_expression(const std::vector<lexer::token>& tokens,
+                                                            std::size_t& index);
+
+  /**
+   * Parses the next expression, reading tokens from the specified function. The function must
+   * keep returning an `eof` token once it reaches the end of its input.
+   *
+   * Returns `nullptr` if the first token is `eof`.
+   *
+   * @exception lexer::parse_error
+   * Thrown if the tokens do not form a valid expression. Any exception thrown by the function is
+   * passed on to the caller.
+   */
+  std::unique_ptr<const lexer::expression> parse_expression(
+    const std::function<lexer::token()>& next_token);
+
+}
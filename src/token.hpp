@@ -8,6 +8,7 @@
 
 /* -- Includes -- */
 
+#include <cstddef>
 #include <string>
 #include <utility>
 
@@ -43,7 +44,8 @@ namespace lexer
       : m_type(),
         m_lexeme(),
         m_line_number(),
-        m_column_number()
+        m_column_number(),
+        m_offset()
     { }
 
     /* -- Public Methods -- */
@@ -98,6 +100,18 @@ namespace lexer
       m_column_number = column_number;
     }
 
+    /** Returns the offset in the input at which this token was found. */
+    std::size_t offset() const
+    {
+      return m_offset;
+    }
+
+    /** Sets the offset in the input at which this token was found. */
+    void set_offset(std::size_t offset)
+    {
+      m_offset = offset;
+    }
+
     /* -- Implementation -- */
 
   private:
@@ -106,6 +120,7 @@ namespace lexer
     std::string m_lexeme;
     int m_line_number;
     int m_column_number;
+    std::size_t m_offset;
 
   };
 
@@ -0,0 +1,72 @@
+/**
+ * @file	token_stream.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/23
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "lexical_analyzer.hpp"
+#include "result.hpp"
+#include "token.hpp"
+#include "token_stream.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Procedures -- */
+
+const size_t token_stream::default_lookahead;
+
+token_stream::token_stream(lexical_analyzer& lex, size_t lookahead)
+  : m_lex(lex),
+    m_buffer(max<size_t>(lookahead, 1)),
+    m_head(0),
+    m_count(0)
+{
+}
+
+const token& token_stream::peek(size_t offset)
+{
+  if (offset >= m_buffer.size())
+    throw out_of_range("Cannot peek that far ahead!");
+
+  while (m_count <= offset)
+  {
+    m_buffer[(m_head + m_count) % m_buffer.size()] = m_lex.next_token();
+    m_count++;
+  }
+  return m_buffer[(m_head + offset) % m_buffer.size()];
+}
+
+void token_stream::advance()
+{
+  if (m_count == 0)
+    m_lex.next_token();
+  else
+  {
+    m_head = (m_head + 1) % m_buffer.size();
+    m_count--;
+  }
+}
+
+token token_stream::next()
+{
+  peek();
+  auto tok = move(m_buffer[m_head]);
+  advance();
+  return tok;
+}
+
+result<token> token_stream::try_next()
+{
+  if (m_count == 0)
+    return m_lex.try_next_token();
+  return next();
+}
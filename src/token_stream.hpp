@@ -0,0 +1,208 @@
+/**
+ * @file	token_stream.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/23
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "lexical_analyzer.hpp"
+#include "result.hpp"
+#include "token.hpp"
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class providing pull-based access to the tokens from a `lexer::lexical_analyzer`, with a
+   * fixed amount of lookahead.
+   *
+   * Tokens are read from the lexer only when they are first needed, into a small ring buffer, and
+   * are handed out by reference. A reference stays valid until the token is consumed and enough
+   * tokens have been read after it to reuse its slot in the buffer.
+   *
+   * The stream can also be used as a range of input iterators, which visits every token up to but
+   * not including the `eof` token, consuming them as it goes.
+   */
+  class token_stream
+  {
+
+    /* -- Constants -- */
+
+  public:
+
+    /** Default number of tokens which can be peeked at. */
+    static const std::size_t default_lookahead = 4;
+
+    /* -- Types -- */
+
+  public:
+
+    /**
+     * Input iterator over the tokens of a stream. All iterators over a stream share its position,
+     * so incrementing one consumes a token for all of them.
+     */
+    class iterator
+    {
+
+    public:
+
+      using iterator_category = std::input_iterator_tag;
+      using value_type = lexer::token;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const lexer::token*;
+      using reference = const lexer::token&;
+
+      /** Constructs an end iterator. */
+      iterator()
+        : m_stream(nullptr)
+      { }
+
+      /** Constructs an iterator over the specified stream. */
+      explicit iterator(lexer::token_stream& stream)
+        : m_stream(&stream)
+      { }
+
+      /** Returns the current token. */
+      reference operator*() const
+      {
+        return m_stream->peek();
+      }
+
+      /** Returns the current token. */
+      pointer operator->() const
+      {
+        return &m_stream->peek();
+      }
+
+      /** Consumes the current token. */
+      iterator& operator++()
+      {
+        m_stream->advance();
+        return *this;
+      }
+
+      /** Consumes the current token, returning a proxy which still holds it. */
+      class postfix_proxy
+      {
+      public:
+        explicit postfix_proxy(lexer::token tok)
+          : m_token(std::move(tok))
+        { }
+        const lexer::token& operator*() const
+        {
+          return m_token;
+        }
+      private:
+        lexer::token m_token;
+      };
+
+      /** Consumes the current token, returning a proxy which still holds it. */
+      postfix_proxy operator++(int)
+      {
+        return postfix_proxy(m_stream->next());
+      }
+
+      /** Returns `true` if both iterators are at the end, or are over the same stream. */
+      bool operator==(const iterator& other) const
+      {
+        return (at_end() == other.at_end() && (at_end() || m_stream == other.m_stream));
+      }
+
+      /** Returns `true` unless both iterators are at the end, or are over the same stream. */
+      bool operator!=(const iterator& other) const
+      {
+        return !(*this == other);
+      }
+
+    private:
+
+      bool at_end() const
+      {
+        return (!m_stream || m_stream->peek().type() == lexer::token_type::eof);
+      }
+
+      lexer::token_stream* m_stream;
+
+    };
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /**
+     * Constructs a new `lexer::token_stream` instance reading from the specified lexer, which can
+     * peek at up to `lookahead` tokens ahead.
+     */
+    token_stream(lexer::lexical_analyzer& lex, std::size_t lookahead = default_lookahead);
+
+    token_stream(const token_stream&) = delete;
+    token_stream& operator=(const token_stream&) = delete;
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the maximum number of tokens which can be peeked at. */
+    std::size_t lookahead() const
+    {
+      return m_buffer.size();
+    }
+
+    /**
+     * Returns the token `offset` tokens ahead, without consuming anything. The lexer returns `eof`
+     * tokens forever once it reaches the end of the input, so this is always valid.
+     *
+     * @exception std::out_of_range
+     * Thrown if `offset` is not less than `lookahead()`.
+     *
+     * @exception lexer::invalid_token_error
+     * Thrown if a token which has to be read is invalid.
+     */
+    const lexer::token& peek(std::size_t offset = 0);
+
+    /** Consumes the next token. */
+    void advance();
+
+    /** Consumes the next token and returns it, moving it out of the buffer rather than copying. */
+    lexer::token next();
+
+    /**
+     * Consumes the next token and returns it, or returns a diagnostic rather than throwing if the
+     * lexer finds an invalid token. Nothing is consumed in that case.
+     */
+    lexer::result<lexer::token> try_next();
+
+    /** Returns an iterator at the next token. */
+    iterator begin()
+    {
+      return iterator(*this);
+    }
+
+    /** Returns the end iterator. */
+    iterator end()
+    {
+      return iterator();
+    }
+
+    /* -- Implementation -- */
+
+  private:
+
+    lexer::lexical_analyzer& m_lex;
+    std::vector<lexer::token> m_buffer;
+    std::size_t m_head;
+    std::size_t m_count;
+
+  };
+
+}
@@ -0,0 +1,149 @@
+/**
+ * @file	work_stealing_pool.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/21
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "work_stealing_pool.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace lexer;
+
+/* -- Procedures -- */
+
+work_stealing_pool& work_stealing_pool::global()
+{
+  static work_stealing_pool pool;
+  return pool;
+}
+
+size_t work_stealing_pool::default_thread_count()
+{
+  return max<size_t>(thread::hardware_concurrency(), 1);
+}
+
+work_stealing_pool::work_stealing_pool(size_t thread_count)
+  : m_task(nullptr),
+    m_generation(0),
+    m_remaining(0),
+    m_stopping(false)
+{
+  thread_count = max<size_t>(thread_count, 1);
+  for (size_t idx = 0; idx < thread_count; idx++)
+    m_queues.push_back(make_unique<queue>());
+  for (size_t idx = 0; idx < thread_count; idx++)
+    m_threads.emplace_back(&work_stealing_pool::worker, this, idx);
+}
+
+work_stealing_pool::~work_stealing_pool()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_start.notify_all();
+  for (auto& thread : m_threads)
+    thread.join();
+}
+
+void work_stealing_pool::run(size_t count, const function<void(size_t)>& task)
+{
+  if (count == 0)
+    return;
+
+  lock_guard<mutex> run_lock(m_run_mutex);
+  unique_lock<mutex> lock(m_mutex);
+
+  // give each worker a contiguous block of tasks, so that neighbouring tasks run on one thread
+  m_generation++;
+  auto workers = m_queues.size();
+  for (size_t idx = 0; idx < workers; idx++)
+  {
+    lock_guard<mutex> queue_lock(m_queues[idx]->mutex);
+    for (auto task_idx = idx * count / workers; task_idx < (idx + 1) * count / workers; task_idx++)
+      m_queues[idx]->tasks.push_back({ m_generation, task_idx });
+  }
+
+  m_task = &task;
+  m_remaining = count;
+  m_start.notify_all();
+  m_finish.wait(lock, [this] { return m_remaining == 0; });
+  m_task = nullptr;
+}
+
+void work_stealing_pool::worker(size_t index)
+{
+  size_t generation = 0;
+  while (true)
+  {
+    const function<void(size_t)>* task = nullptr;
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_start.wait(lock, [&] { return m_stopping || m_generation != generation; });
+      if (m_stopping)
+        return;
+      generation = m_generation;
+      task = m_task;
+    }
+
+    size_t done = 0;
+    size_t task_idx = 0;
+    while (next_task(index, generation, task_idx))
+    {
+      (*task)(task_idx);
+      done++;
+    }
+
+    if (done != 0)
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_remaining -= done;
+      if (m_remaining == 0)
+        m_finish.notify_all();
+    }
+  }
+}
+
+bool work_stealing_pool::next_task(size_t index, size_t generation, size_t& task)
+{
+  // a worker which is late to finish one batch may see the tasks of the next one, which it must
+  // leave until it has picked up the next batch's task function
+  // take from the front of our own queue first
+  {
+    auto& own = *m_queues[index];
+    lock_guard<mutex> lock(own.mutex);
+    if (!own.tasks.empty() && own.tasks.front().generation == generation)
+    {
+      task = own.tasks.front().index;
+      own.tasks.pop_front();
+      return true;
+    }
+  }
+
+  // then steal from the back of the others, starting with our neighbour
+  for (size_t offset = 1; offset < m_queues.size(); offset++)
+  {
+    auto& other = *m_queues[(index + offset) % m_queues.size()];
+    lock_guard<mutex> lock(other.mutex);
+    if (!other.tasks.empty() && other.tasks.back().generation == generation)
+    {
+      task = other.tasks.back().index;
+      other.tasks.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+}
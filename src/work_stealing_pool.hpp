@@ -0,0 +1,104 @@
+/**
+ * @file	work_stealing_pool.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/21
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* -- Types -- */
+
+namespace lexer
+{
+
+  /**
+   * Class representing a pool of worker threads which run batches of indexed tasks.
+   *
+   * Each batch is divided evenly between the workers up front. A worker which runs out of tasks
+   * steals from the far end of another worker's queue, so uneven tasks still keep every worker
+   * busy until the batch is done.
+   */
+  class work_stealing_pool
+  {
+
+    /* -- Lifecycle -- */
+
+  public:
+
+    /** Returns a process-wide pool with one worker per hardware thread. */
+    static lexer::work_stealing_pool& global();
+
+    /** Constructs a new `lexer::work_stealing_pool` instance with the specified number of workers. */
+    work_stealing_pool(std::size_t thread_count = default_thread_count());
+
+    /** Destructor. Waits for the workers to exit. */
+    ~work_stealing_pool();
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    /* -- Public Methods -- */
+
+  public:
+
+    /** Returns the number of worker threads. */
+    std::size_t thread_count() const
+    {
+      return m_threads.size();
+    }
+
+    /**
+     * Calls `task(idx)` for each `idx` in `[0, count)` on the worker threads, and waits for all of
+     * the calls to finish. Batches from different threads are run one at a time.
+     *
+     * @note
+     * The task must not throw.
+     */
+    void run(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    /* -- Implementation -- */
+
+  private:
+
+    struct entry
+    {
+      std::size_t generation;
+      std::size_t index;
+    };
+
+    struct queue
+    {
+      std::mutex mutex;
+      std::deque<entry> tasks;
+    };
+
+    static std::size_t default_thread_count();
+
+    void worker(std::size_t index);
+    bool next_task(std::size_t index, std::size_t generation, std::size_t& task);
+
+    std::mutex m_run_mutex;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_finish;
+    const std::function<void(std::size_t)>* m_task;
+    std::size_t m_generation;
+    std::size_t m_remaining;
+    bool m_stopping;
+    std::vector<std::unique_ptr<queue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+  };
+
+}
@@ -0,0 +1,142 @@
+/**
+ * @file	diagnostic_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/24
+ */
+
+/* -- Includes -- */
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "diagnostic.hpp"
+#include "expression.hpp"
+#include "expression_test_helpers.hpp"
+#include "lexical_analyzer.hpp"
+#include "syntax_analyzer.hpp"
+#include "token.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for recovering from errors with `lexer::diagnostic`s.
+ */
+class diagnostic_tests : public Test
+{
+protected:
+
+  /** Parses an input in recovery mode, returning the flattened expressions. */
+  static vector<string> parse(const string& input, vector<diagnostic>& diagnostics)
+  {
+    lexical_analyzer lex(input, diagnostics);
+    syntax_analyzer syn(lex, diagnostics);
+
+    vector<string> expressions;
+    while (auto expr = syn.next_expression())
+      expressions.push_back(flatten(*expr));
+    return expressions;
+  }
+
+  /** Returns the message of the exception thrown by parsing an input normally. */
+  static string exception_message(const string& input)
+  {
+    try
+    {
+      lexical_analyzer lex(input);
+      syntax_analyzer syn(lex);
+      while (syn.next_expression())
+        ;
+    }
+    catch (const exception& ex)
+    {
+      return ex.what();
+    }
+    return string();
+  }
+
+};
+
+/**
+ * Verify that the lexer skips invalid tokens, recording where they were.
+ */
+TEST_F(diagnostic_tests, invalid_tokens)
+{
+  string input = "1 %% 2\n3&4 x";
+  vector<diagnostic> diagnostics;
+  lexical_analyzer lex(input, diagnostics);
+
+  vector<string> lexemes;
+  for (auto tok = lex.next_token(); tok.type() != token_type::eof; tok = lex.next_token())
+    lexemes.push_back(tok.lexeme());
+  EXPECT_EQ(lexemes, (vector<string> { "1", "2", "3", "4" }));
+
+  ASSERT_EQ(diagnostics.size(), 3u);
+  EXPECT_EQ(diagnostics[0].kind, diagnostic_kind::invalid_token);
+  EXPECT_EQ(diagnostics[0].offset, 2u);
+  EXPECT_EQ(diagnostics[0].length, 2u);
+  EXPECT_EQ(diagnostics[1].offset, 8u);
+  EXPECT_EQ(diagnostics[1].length, 1u);
+  EXPECT_EQ(diagnostics[1].line_number, 1);
+  EXPECT_EQ(diagnostics[1].column_number, 1);
+  EXPECT_EQ(diagnostics[2].offset, 11u);
+
+  // the message is the same as the exception's
+  EXPECT_EQ(diagnostic_message(diagnostics[0], input), exception_message(input));
+}
+
+/**
+ * Verify that the parser skips to the next top-level expression after an error.
+ */
+TEST_F(diagnostic_tests, unexpected_tokens)
+{
+  vector<diagnostic> diagnostics;
+  auto expressions = parse("(1 + 2) (3 4) (5 * (6 / 7)) + (8 / 9 9) (10 + 11)", diagnostics);
+  EXPECT_EQ(expressions, (vector<string> { "(1 + 2)", "(5 * (6 / 7))", "(10 + 11)" }));
+
+  ASSERT_EQ(diagnostics.size(), 3u);
+  EXPECT_EQ(diagnostics[0].kind, diagnostic_kind::unexpected_token);
+  EXPECT_EQ(diagnostics[0].offset, 11u);
+  EXPECT_EQ(diagnostics[1].offset, 28u);
+  EXPECT_EQ(diagnostics[2].offset, 30u);
+
+  // the messages are the same as the exceptions', which blame the open bracket of an expression
+  // that is not closed where it should be
+  EXPECT_EQ(diagnostic_message(diagnostics[0], "(1 + 2) (3 4)"), exception_message("(1 + 2) (3 4)"));
+}
+
+/**
+ * Verify that invalid tokens and unexpected tokens are both recovered from in one pass.
+ */
+TEST_F(diagnostic_tests, corrupt_records)
+{
+  string input;
+  for (int idx = 0; idx < 100; idx++)
+    input += (idx % 10 == 5 ? "(1 + #)\n" : "(" + to_string(idx) + " * 2)\n");
+
+  vector<diagnostic> diagnostics;
+  auto expressions = parse(input, diagnostics);
+  EXPECT_EQ(expressions.size(), 90u);
+  ASSERT_EQ(diagnostics.size(), 20u);
+  for (size_t idx = 0; idx < diagnostics.size(); idx += 2)
+  {
+    EXPECT_EQ(diagnostics[idx].kind, diagnostic_kind::invalid_token);
+    EXPECT_EQ(diagnostics[idx + 1].kind, diagnostic_kind::unexpected_token);
+    EXPECT_EQ(input[diagnostics[idx + 1].offset], ')');
+  }
+
+  // an unfinished expression at the end is reported, but ends the input
+  diagnostics.clear();
+  expressions = parse("(1 + 2) (3 +", diagnostics);
+  EXPECT_EQ(expressions.size(), 1u);
+  ASSERT_EQ(diagnostics.size(), 1u);
+  EXPECT_EQ(diagnostics[0].offset, 8u);
+}
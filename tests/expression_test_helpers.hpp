@@ -0,0 +1,68 @@
+/**
+ * @file	expression_test_helpers.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/27
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <random>
+#include <string>
+
+#include "expression.hpp"
+
+/* -- Procedures -- */
+
+namespace lexer
+{
+
+  /** Returns `true` if two expression trees are the same. */
+  inline bool expressions_equal(const lexer::expression& expr1, const lexer::expression& expr2)
+  {
+    if (expr1.type() != expr2.type())
+      return false;
+    if (expr1.type() == lexer::expression_type::simple)
+    {
+      return (static_cast<const lexer::simple_expression&>(expr1).value() ==
+              static_cast<const lexer::simple_expression&>(expr2).value());
+    }
+
+    const auto& compound1 = static_cast<const lexer::compound_expression&>(expr1);
+    const auto& compound2 = static_cast<const lexer::compound_expression&>(expr2);
+    return (compound1.operator_type() == compound2.operator_type() &&
+            expressions_equal(*compound1.left_expression(), *compound2.left_expression()) &&
+            expressions_equal(*compound1.right_expression(), *compound2.right_expression()));
+  }
+
+  /** Returns the values of the simple expressions and operators in an expression, in order. */
+  inline std::string flatten(const lexer::expression& expr)
+  {
+    if (expr.type() == lexer::expression_type::simple)
+      return std::to_string(static_cast<const lexer::simple_expression&>(expr).value());
+
+    const auto& compound = static_cast<const lexer::compound_expression&>(expr);
+    return ("(" + flatten(*compound.left_expression()) + " " +
+            lexer::operator_type_string(compound.operator_type()) + " " +
+            flatten(*compound.right_expression()) + ")");
+  }
+
+  /**
+   * Returns a random, fully parenthesized expression, with `separator` between each operator and
+   * its right operand.
+   */
+  inline std::string random_expression(std::mt19937& rng,
+                                       int depth,
+                                       const std::string& separator = " ")
+  {
+    if (depth == 0 || std::uniform_int_distribution<int>(0, 2)(rng) == 0)
+      return std::to_string(std::uniform_int_distribution<int>(0, 999)(rng));
+
+    static const std::string ops = "+*/";
+    return ("(" + random_expression(rng, depth - 1, separator) + " " +
+            ops[std::uniform_int_distribution<std::size_t>(0, ops.size() - 1)(rng)] + separator +
+            random_expression(rng, depth - 1, separator) + ")");
+  }
+
+}
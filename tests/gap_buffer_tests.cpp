@@ -0,0 +1,110 @@
+/**
+ * @file	gap_buffer_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+/* -- Includes -- */
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "gap_buffer.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::gap_buffer` class.
+ */
+class gap_buffer_tests : public Test
+{
+protected:
+
+  /** Returns the elements of a buffer, in order. */
+  static vector<string> contents(const gap_buffer<string>& buffer)
+  {
+    vector<string> items;
+    for (size_t idx = 0; idx < buffer.size(); idx++)
+      items.push_back(buffer[idx]);
+    return items;
+  }
+
+};
+
+/**
+ * Verify that elements are inserted and removed at the gap, wherever it is.
+ */
+TEST_F(gap_buffer_tests, edits)
+{
+  gap_buffer<string> buffer({ "a", "b", "c", "d" });
+  EXPECT_EQ(buffer.size(), 4u);
+  EXPECT_EQ(buffer.gap(), 4u);
+
+  auto ignore = [] (string&, bool) { };
+  buffer.move_gap(2, ignore);
+  EXPECT_EQ(contents(buffer), (vector<string> { "a", "b", "c", "d" }));
+  buffer.erase_before_gap(1);
+  buffer.insert_before_gap("x");
+  buffer.insert_before_gap("y");
+  EXPECT_EQ(buffer.gap(), 3u);
+  EXPECT_EQ(contents(buffer), (vector<string> { "a", "x", "y", "c", "d" }));
+
+  // enough insertions to grow the buffer more than once
+  buffer.move_gap(5, ignore);
+  for (int idx = 0; idx < 40; idx++)
+    buffer.insert_before_gap(to_string(idx));
+  buffer.move_gap(0, ignore);
+  buffer.insert_before_gap("start");
+  ASSERT_EQ(buffer.size(), 46u);
+  EXPECT_EQ(buffer[0], "start");
+  EXPECT_EQ(buffer[1], "a");
+  EXPECT_EQ(buffer[5], "d");
+  EXPECT_EQ(buffer[45], "39");
+}
+
+/**
+ * Verify that each element which crosses the gap is reported once, in the direction it moved.
+ */
+TEST_F(gap_buffer_tests, crossing)
+{
+  gap_buffer<string> buffer({ "a", "b", "c", "d", "e" });
+
+  string after;
+  buffer.move_gap(1, [&] (string& item, bool before) {
+      EXPECT_FALSE(before);
+      after = item + after;
+      item += "'";
+    });
+  EXPECT_EQ(after, "bcde");
+
+  string before;
+  buffer.move_gap(3, [&] (string& item, bool is_before) {
+      EXPECT_TRUE(is_before);
+      before += item;
+    });
+  EXPECT_EQ(before, "b'c'");
+  EXPECT_EQ(contents(buffer), (vector<string> { "a", "b'", "c'", "d'", "e'" }));
+}
+
+/**
+ * Verify that `lexer::partition_index` finds the first index failing a predicate.
+ */
+TEST_F(gap_buffer_tests, partition_index)
+{
+  vector<int> values { 1, 3, 5, 7, 9 };
+  auto less_than = [&] (int value) {
+    return partition_index(0, values.size(), [&] (size_t idx) { return values[idx] < value; });
+  };
+  EXPECT_EQ(less_than(0), 0u);
+  EXPECT_EQ(less_than(5), 2u);
+  EXPECT_EQ(less_than(6), 3u);
+  EXPECT_EQ(less_than(10), 5u);
+  EXPECT_EQ(partition_index(2, 2, [] (size_t) { return true; }), 2u);
+}
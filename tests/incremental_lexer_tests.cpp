@@ -0,0 +1,172 @@
+/**
+ * @file	incremental_lexer_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+/* -- Includes -- */
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "incremental_lexer.hpp"
+#include "lexical_analyzer.hpp"
+#include "token.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::incremental_lexer` class.
+ */
+class incremental_lexer_tests : public Test
+{
+protected:
+
+  /** Lexes the whole of the specified input with a `lexer::lexical_analyzer`. */
+  static vector<token> lex_all(const string& input)
+  {
+    lexical_analyzer lex(input);
+    vector<token> tokens;
+    do
+      tokens.push_back(lex.next_token());
+    while (tokens.back().type() != token_type::eof);
+    return tokens;
+  }
+
+  /** Verifies that the incremental lexer's tokens match lexing its input from scratch. */
+  static void verify(const incremental_lexer& lex)
+  {
+    auto expected = lex_all(lex.input());
+    const auto& actual = lex.tokens();
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t idx = 0; idx < actual.size(); idx++)
+    {
+      EXPECT_EQ(actual[idx].type(), expected[idx].type());
+      EXPECT_EQ(actual[idx].lexeme(), expected[idx].lexeme());
+      EXPECT_EQ(actual[idx].line_number(), expected[idx].line_number());
+      EXPECT_EQ(actual[idx].column_number(), expected[idx].column_number());
+      EXPECT_EQ(actual[idx].offset(), expected[idx].offset());
+    }
+  }
+
+};
+
+/**
+ * Verify that tokens record their offsets in the input.
+ */
+TEST_F(incremental_lexer_tests, offsets)
+{
+  auto tokens = lex_all("(12 +\n 3)");
+  ASSERT_EQ(tokens.size(), 6u);
+  EXPECT_EQ(tokens[0].offset(), 0u);
+  EXPECT_EQ(tokens[1].offset(), 1u);
+  EXPECT_EQ(tokens[2].offset(), 4u);
+  EXPECT_EQ(tokens[3].offset(), 7u);
+  EXPECT_EQ(tokens[3].line_number(), 1);
+  EXPECT_EQ(tokens[3].column_number(), 1);
+  EXPECT_EQ(tokens[4].offset(), 8u);
+  EXPECT_EQ(tokens[5].offset(), 9u);
+}
+
+/**
+ * Verify that only the tokens touched by an edit are re-lexed.
+ */
+TEST_F(incremental_lexer_tests, changed_range)
+{
+  incremental_lexer lex("(1 + 2)\n(3 * 4)\n(5 / 6)");
+
+  // replacing a number replaces just that token
+  auto change = lex.apply({ 9, 1, "333" });
+  EXPECT_EQ(change.first, 6u);
+  EXPECT_EQ(change.removed, 1u);
+  EXPECT_EQ(change.inserted, 1u);
+  EXPECT_EQ(lex.input(), "(1 + 2)\n(333 * 4)\n(5 / 6)");
+  verify(lex);
+
+  // appending digits to a number changes it, even though the edit is just after it
+  change = lex.apply({ 2, 0, "0" });
+  EXPECT_EQ(change.first, 1u);
+  EXPECT_EQ(change.removed, 1u);
+  EXPECT_EQ(change.inserted, 1u);
+  EXPECT_EQ(lex.tokens()[1].lexeme(), "10");
+  verify(lex);
+
+  // inserting whitespace changes no tokens, but moves the ones after it
+  change = lex.apply({ 0, 0, "\n\n  " });
+  EXPECT_EQ(change.removed, 0u);
+  EXPECT_EQ(change.inserted, 0u);
+  verify(lex);
+
+  // splitting a number makes two tokens
+  EXPECT_EQ(lex.input(), "\n\n  (10 + 2)\n(333 * 4)\n(5 / 6)");
+  change = lex.apply({ 15, 1, " " });
+  EXPECT_EQ(change.first, 6u);
+  EXPECT_EQ(change.removed, 1u);
+  EXPECT_EQ(change.inserted, 2u);
+  verify(lex);
+}
+
+/**
+ * Verify that random edits produce the same tokens as lexing from scratch.
+ */
+TEST_F(incremental_lexer_tests, random_edits)
+{
+  static const string alphabet = "0123456789+*/() \n";
+
+  mt19937 rng(43);
+  auto random_text = [&] (size_t max) {
+    string text(uniform_int_distribution<size_t>(0, max)(rng), ' ');
+    for (auto& ch : text)
+      ch = alphabet[uniform_int_distribution<size_t>(0, alphabet.size() - 1)(rng)];
+    return text;
+  };
+
+  incremental_lexer lex(random_text(200));
+  verify(lex);
+
+  for (int iteration = 0; iteration < 500; iteration++)
+  {
+    auto offset = uniform_int_distribution<size_t>(0, lex.input().size())(rng);
+    auto removed = uniform_int_distribution<size_t>(0, min<size_t>(lex.input().size() - offset, 5))(rng);
+    auto old_tokens = lex.tokens();
+
+    auto change = lex.apply({ offset, removed, random_text(5) });
+    verify(lex);
+
+    // everything outside the changed range is the same token as before
+    const auto& tokens = lex.tokens();
+    ASSERT_EQ(tokens.size(), old_tokens.size() - change.removed + change.inserted);
+    for (size_t idx = 0; idx < change.first; idx++)
+      EXPECT_EQ(tokens[idx].offset(), old_tokens[idx].offset());
+    for (size_t idx = change.first + change.inserted; idx < tokens.size(); idx++)
+      EXPECT_EQ(tokens[idx].lexeme(),
+                old_tokens[idx - change.inserted + change.removed].lexeme());
+  }
+}
+
+/**
+ * Verify that invalid edits throw, leaving the lexer unchanged.
+ */
+TEST_F(incremental_lexer_tests, errors)
+{
+  incremental_lexer lex("(1 + 2)");
+  auto tokens = lex.tokens();
+
+  EXPECT_THROW(lex.apply({ 8, 0, "1" }), out_of_range);
+  EXPECT_THROW(lex.apply({ 5, 3, "1" }), out_of_range);
+  EXPECT_THROW(lex.apply({ 3, 1, "x" }), invalid_token_error);
+  EXPECT_EQ(lex.input(), "(1 + 2)");
+  EXPECT_EQ(lex.tokens().size(), tokens.size());
+  verify(lex);
+
+  EXPECT_THROW(incremental_lexer("(1 % 2)"), invalid_token_error);
+}
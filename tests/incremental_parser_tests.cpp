@@ -0,0 +1,179 @@
+/**
+ * @file	incremental_parser_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "expression.hpp"
+#include "expression_test_helpers.hpp"
+#include "incremental_parser.hpp"
+#include "lexical_analyzer.hpp"
+#include "syntax_analyzer.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::incremental_parser` class.
+ */
+class incremental_parser_tests : public Test
+{
+protected:
+
+  /** Verifies that the incremental parser's expressions match parsing its input from scratch. */
+  static void verify(const incremental_parser& parser)
+  {
+    lexical_analyzer lex(parser.input());
+    syntax_analyzer syn(lex);
+    for (const auto& parsed : parser.expressions())
+    {
+      auto expected = syn.next_expression();
+      ASSERT_TRUE(expected);
+      EXPECT_TRUE(expressions_equal(*parsed.expr, *expected));
+
+      size_t index = parsed.first_token;
+      EXPECT_TRUE(parse_expression(parser.tokens(), index));
+      EXPECT_EQ(index, parsed.first_token + parsed.token_count);
+    }
+    EXPECT_FALSE(syn.next_expression());
+  }
+
+};
+
+/**
+ * Verify that parsing a token stream consumes exactly one expression.
+ */
+TEST_F(incremental_parser_tests, parse_expression)
+{
+  incremental_parser parser("(1 + (2 * 3)) 4\n(5 / 6)");
+  const auto& expressions = parser.expressions();
+  ASSERT_EQ(expressions.size(), 3u);
+  EXPECT_EQ(expressions[0].first_token, 0u);
+  EXPECT_EQ(expressions[0].token_count, 9u);
+  EXPECT_EQ(expressions[1].first_token, 9u);
+  EXPECT_EQ(expressions[1].token_count, 1u);
+  EXPECT_EQ(expressions[2].first_token, 10u);
+  EXPECT_EQ(expressions[2].token_count, 5u);
+  verify(parser);
+}
+
+/**
+ * Verify that only the expressions touched by an edit are re-parsed.
+ */
+TEST_F(incremental_parser_tests, reuse)
+{
+  incremental_parser parser("(1 + 2)\n(3 * 4)\n(5 / 6)");
+  auto old_expressions = parser.expressions();
+
+  // changing a number re-parses just its expression
+  auto change = parser.apply({ 13, 1, "40" });
+  EXPECT_EQ(change.first, 1u);
+  EXPECT_EQ(change.removed, 1u);
+  EXPECT_EQ(change.inserted, 1u);
+  ASSERT_EQ(parser.expressions().size(), 3u);
+  EXPECT_EQ(parser.expressions()[0].expr, old_expressions[0].expr);
+  EXPECT_NE(parser.expressions()[1].expr, old_expressions[1].expr);
+  EXPECT_EQ(parser.expressions()[2].expr, old_expressions[2].expr);
+  EXPECT_EQ(parser.expressions()[2].first_token, 10u);
+  verify(parser);
+
+  // inserting an expression between two others leaves both alone
+  old_expressions = parser.expressions();
+  change = parser.apply({ 7, 0, " 7 (8 + 9)" });
+  EXPECT_EQ(change.first, 1u);
+  EXPECT_EQ(change.removed, 0u);
+  EXPECT_EQ(change.inserted, 2u);
+  ASSERT_EQ(parser.expressions().size(), 5u);
+  EXPECT_EQ(parser.expressions()[0].expr, old_expressions[0].expr);
+  EXPECT_EQ(parser.expressions()[3].expr, old_expressions[1].expr);
+  EXPECT_EQ(parser.expressions()[4].expr, old_expressions[2].expr);
+  verify(parser);
+
+  // merging three expressions into one
+  old_expressions = parser.expressions();
+  change = parser.apply({ 0, 17, "((1 + 2) * (8 + 9))" });
+  EXPECT_EQ(parser.input(), "((1 + 2) * (8 + 9))\n(3 * 40)\n(5 / 6)");
+  EXPECT_EQ(change.first, 0u);
+  EXPECT_EQ(change.removed, 3u);
+  EXPECT_EQ(change.inserted, 1u);
+  ASSERT_EQ(parser.expressions().size(), 3u);
+  EXPECT_EQ(parser.expressions()[1].expr, old_expressions[3].expr);
+  verify(parser);
+}
+
+/**
+ * Verify that edits which keep the input valid produce the same expressions as parsing from
+ * scratch.
+ */
+TEST_F(incremental_parser_tests, random_edits)
+{
+  mt19937 rng(44);
+
+  string input;
+  for (int idx = 0; idx < 20; idx++)
+    input += random_expression(rng, 4) + "\n";
+  incremental_parser parser(input);
+  verify(parser);
+
+  for (int iteration = 0; iteration < 200; iteration++)
+  {
+    // replace a whole expression, or insert a new one between two others
+    const auto& expressions = parser.expressions();
+    const auto& tokens = parser.tokens();
+    auto idx = uniform_int_distribution<size_t>(0, expressions.size())(rng);
+    text_edit edit { 0, 0, " " + random_expression(rng, 4) + " " };
+    if (idx < expressions.size() && uniform_int_distribution<int>(0, 1)(rng) == 0)
+    {
+      const auto& first = tokens[expressions[idx].first_token];
+      const auto& last = tokens[expressions[idx].first_token + expressions[idx].token_count - 1];
+      edit.offset = first.offset();
+      edit.removed = last.offset() + last.lexeme().size() - first.offset();
+    }
+    else
+      edit.offset = (idx < expressions.size() ? tokens[expressions[idx].first_token].offset() :
+                     parser.input().size());
+
+    auto old_expressions = expressions;
+    auto change = parser.apply(edit);
+    verify(parser);
+
+    // everything outside the changed range is the same tree as before
+    const auto& updated = parser.expressions();
+    for (size_t idx = 0; idx < change.first; idx++)
+      EXPECT_EQ(updated[idx].expr, old_expressions[idx].expr);
+    for (size_t idx = change.first + change.inserted; idx < updated.size(); idx++)
+      EXPECT_EQ(updated[idx].expr, old_expressions[idx - change.inserted + change.removed].expr);
+  }
+}
+
+/**
+ * Verify that edits which make the input invalid throw, leaving the parser unchanged.
+ */
+TEST_F(incremental_parser_tests, errors)
+{
+  incremental_parser parser("(1 + 2) (3 * 4)");
+  auto old_expressions = parser.expressions();
+
+  EXPECT_THROW(parser.apply({ 0, 1, "" }), parse_error);
+  EXPECT_THROW(parser.apply({ 3, 1, "x" }), invalid_token_error);
+  EXPECT_THROW(parser.apply({ 16, 0, "" }), out_of_range);
+
+  EXPECT_EQ(parser.input(), "(1 + 2) (3 * 4)");
+  ASSERT_EQ(parser.expressions().size(), 2u);
+  EXPECT_EQ(parser.expressions()[0].expr, old_expressions[0].expr);
+  EXPECT_EQ(parser.expressions()[1].expr, old_expressions[1].expr);
+  verify(parser);
+}
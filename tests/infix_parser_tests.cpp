@@ -0,0 +1,160 @@
+/**
+ * @file	infix_parser_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/26
+ */
+
+/* -- Includes -- */
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "expression.hpp"
+#include "expression_test_helpers.hpp"
+#include "infix_parser.hpp"
+#include "lexical_analyzer.hpp"
+#include "syntax_analyzer.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for `lexer::infix_parser`.
+ */
+class infix_parser_tests : public Test
+{
+protected:
+
+  /** Parses an input, returning the flattened expressions. */
+  static vector<string> parse(const string& input)
+  {
+    lexical_analyzer lex(input);
+    infix_parser parser(lex);
+
+    vector<string> expressions;
+    while (auto expr = parser.next_expression())
+      expressions.push_back(flatten(*expr));
+    return expressions;
+  }
+
+  /** Returns the message of the exception thrown by parsing an input. */
+  static string error_message(const string& input)
+  {
+    try
+    {
+      parse(input);
+    }
+    catch (const exception& ex)
+    {
+      return ex.what();
+    }
+    return string();
+  }
+
+  /** Returns the depth of the leftmost path of an expression tree. */
+  static size_t left_depth(const expression* expr)
+  {
+    size_t depth = 1;
+    for (; expr->type() == expression_type::compound; depth++)
+      expr = static_cast<const compound_expression&>(*expr).left_expression().get();
+    return depth;
+  }
+
+};
+
+/**
+ * Verify that operators are parsed with the standard precedence and associativity.
+ */
+TEST_F(infix_parser_tests, precedence)
+{
+  auto plus = operator_type_string(operator_type::addition);
+  auto minus = operator_type_string(operator_type::subtraction);
+  auto times = operator_type_string(operator_type::multiplication);
+  auto divide = operator_type_string(operator_type::division);
+
+  EXPECT_EQ(parse("1 + 2 * 3 - 4 / 5"),
+            (vector<string> { "((1 " + plus + " (2 " + times + " 3)) " + minus +
+                              " (4 " + divide + " 5))" }));
+  EXPECT_EQ(parse("1 - 2 - 3"),
+            (vector<string> { "((1 " + minus + " 2) " + minus + " 3)" }));
+  EXPECT_EQ(parse("8 / 4 * 2"),
+            (vector<string> { "((8 " + divide + " 4) " + times + " 2)" }));
+  EXPECT_EQ(parse("(1 + 2) * 3"),
+            (vector<string> { "((1 " + plus + " 2) " + times + " 3)" }));
+  EXPECT_EQ(parse("42"), (vector<string> { "42" }));
+}
+
+/**
+ * Verify that fully parenthesized expressions are parsed as by `lexer::syntax_analyzer`.
+ */
+TEST_F(infix_parser_tests, parenthesized)
+{
+  string input = "(1 + (2 * 3)) ((4 / 5) - 6) 7";
+
+  lexical_analyzer lex(input);
+  syntax_analyzer syn(lex);
+  vector<string> expected;
+  while (auto expr = syn.next_expression())
+    expected.push_back(flatten(*expr));
+
+  EXPECT_EQ(parse(input), expected);
+}
+
+/**
+ * Verify that a new expression starts after a complete operand.
+ */
+TEST_F(infix_parser_tests, multiple_expressions)
+{
+  auto plus = operator_type_string(operator_type::addition);
+  auto times = operator_type_string(operator_type::multiplication);
+  EXPECT_EQ(parse("1 + 2 3 * 4\n(5)"),
+            (vector<string> { "(1 " + plus + " 2)", "(3 " + times + " 4)", "5" }));
+  EXPECT_TRUE(parse(" \n ").empty());
+}
+
+/**
+ * Verify that long operator chains and deep brackets are parsed.
+ */
+TEST_F(infix_parser_tests, long_chains)
+{
+  static const int count = 100000;
+
+  string chain = "0";
+  for (int idx = 1; idx < count; idx++)
+    chain += (idx % 2 ? " + " : " * ") + to_string(idx);
+  string nested = string(count, '(') + "1" + string(count, ')');
+
+  lexical_analyzer lex(chain + "\n" + nested);
+  infix_parser parser(lex);
+
+  // additions are left associative, and each multiplication binds to the addition before it
+  auto expr = parser.next_expression();
+  ASSERT_NE(expr, nullptr);
+  EXPECT_EQ(left_depth(expr.get()), static_cast<size_t>(count / 2 + 1));
+
+  expr = parser.next_expression();
+  ASSERT_NE(expr, nullptr);
+  EXPECT_EQ(flatten(*expr), "1");
+  EXPECT_EQ(parser.next_expression(), nullptr);
+}
+
+/**
+ * Verify that invalid expressions throw, blaming the right token.
+ */
+TEST_F(infix_parser_tests, errors)
+{
+  EXPECT_EQ(error_message("1 + * 2"), "Unexpected token \"*\" found at line 0, column 4.");
+  EXPECT_EQ(error_message("1 +\n(2 * 3"), "Unexpected token \"(\" found at line 1, column 0.");
+  EXPECT_EQ(error_message("1 + 2)"), "Unexpected token \")\" found at line 0, column 5.");
+  EXPECT_EQ(error_message("(1 + )"), "Unexpected token \")\" found at line 0, column 5.");
+  EXPECT_EQ(error_message("- 1"), "Unexpected token \"-\" found at line 0, column 0.");
+  EXPECT_EQ(error_message("1 +"), "Unexpected token \"\" found at line 0, column 3.");
+}
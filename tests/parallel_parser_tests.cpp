@@ -0,0 +1,155 @@
+/**
+ * @file	parallel_parser_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/21
+ */
+
+/* -- Includes -- */
+
+#include <exception>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "expression.hpp"
+#include "expression_test_helpers.hpp"
+#include "lexical_analyzer.hpp"
+#include "parallel_parser.hpp"
+#include "syntax_analyzer.hpp"
+#include "work_stealing_pool.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for `lexer::split_top_level` and `lexer::parse_parallel`.
+ */
+class parallel_parser_tests : public Test
+{
+protected:
+
+  /** Returns a large input of random expressions. */
+  static string random_input(mt19937& rng)
+  {
+    string input;
+    for (int idx = 0; idx < 500; idx++)
+      input += random_expression(rng, 5, "\n") + (idx % 3 == 0 ? "\n" : " ");
+    return input;
+  }
+
+  /** Returns the message of the error thrown by parsing an input from start to end. */
+  static string serial_error(const string& input)
+  {
+    try
+    {
+      lexical_analyzer lex(input);
+      syntax_analyzer syn(lex);
+      while (syn.next_expression())
+        ;
+    }
+    catch (const exception& ex)
+    {
+      return ex.what();
+    }
+    return string();
+  }
+
+  /** Returns the message of the error thrown by parsing an input in parallel. */
+  static string parallel_error(const string& input, work_stealing_pool& pool)
+  {
+    try
+    {
+      parse_parallel(input, pool);
+    }
+    catch (const exception& ex)
+    {
+      return ex.what();
+    }
+    return string();
+  }
+
+};
+
+/**
+ * Verify that inputs are only split between top-level expressions, at the right locations.
+ */
+TEST_F(parallel_parser_tests, split_top_level)
+{
+  string input = "(1 + (2 * 3)) 45\n(6 / 7)\n\n(8 + 9)";
+  auto chunks = split_top_level(input, 1);
+
+  // there is a split after each top-level expression, and before each one not at the start
+  vector<size_t> offsets;
+  for (const auto& chunk : chunks)
+    offsets.push_back(chunk.offset);
+  EXPECT_EQ(offsets, (vector<size_t> { 0, 13, 14, 16, 17, 24, 25, 26 }));
+
+  EXPECT_EQ(chunks[4].line_number, 1);
+  EXPECT_EQ(chunks[4].column_number, 0);
+  EXPECT_EQ(chunks[7].line_number, 3);
+  EXPECT_EQ(chunks[7].column_number, 0);
+
+  // with a larger minimum size, chunks hold several expressions
+  chunks = split_top_level(input, 15);
+  ASSERT_EQ(chunks.size(), 2u);
+  EXPECT_EQ(chunks[1].offset, 16u);
+  EXPECT_EQ(split_top_level(input, 1000).size(), 1u);
+}
+
+/**
+ * Verify that parsing in parallel finds the same expressions as parsing from start to end.
+ */
+TEST_F(parallel_parser_tests, parse_parallel)
+{
+  mt19937 rng(45);
+  auto input = random_input(rng);
+
+  work_stealing_pool pool(4);
+  auto expressions = parse_parallel(input, pool);
+
+  lexical_analyzer lex(input);
+  syntax_analyzer syn(lex);
+  for (const auto& expr : expressions)
+  {
+    auto expected = syn.next_expression();
+    ASSERT_TRUE(expected);
+    EXPECT_TRUE(expressions_equal(*expr, *expected));
+  }
+  EXPECT_FALSE(syn.next_expression());
+
+  EXPECT_TRUE(parse_parallel("", pool).empty());
+}
+
+/**
+ * Verify that errors are reported at the same place as when parsing from start to end.
+ */
+TEST_F(parallel_parser_tests, errors)
+{
+  mt19937 rng(45);
+  auto input = random_input(rng);
+  work_stealing_pool pool(4);
+
+  // errors in the middle of the input, including two at once, where the first must win
+  for (const auto& corruption : { "%", ")", "(", "+ ", "(1 + 2" })
+  {
+    for (auto fraction : { 2, 3, 5 })
+    {
+      auto corrupt = input;
+      auto pos = corrupt.find('(', corrupt.size() / fraction);
+      corrupt.insert(pos, corruption);
+      if (fraction == 5)
+        corrupt.insert(corrupt.find('(', corrupt.size() / 2), "%");
+
+      auto expected = serial_error(corrupt);
+      ASSERT_FALSE(expected.empty());
+      EXPECT_EQ(parallel_error(corrupt, pool), expected) << corruption;
+    }
+  }
+}
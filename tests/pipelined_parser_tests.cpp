@@ -0,0 +1,140 @@
+/**
+ * @file	pipelined_parser_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/22
+ */
+
+/* -- Includes -- */
+
+#include <exception>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "expression.hpp"
+#include "expression_test_helpers.hpp"
+#include "lexical_analyzer.hpp"
+#include "pipelined_parser.hpp"
+#include "syntax_analyzer.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for `lexer::parse_pipelined`.
+ */
+class pipelined_parser_tests : public Test
+{
+protected:
+
+  /** Returns options with tiny batches and queues, so that every stage has to wait. */
+  static pipeline_options tiny_options()
+  {
+    pipeline_options options;
+    options.token_batch_size = 3;
+    options.expression_batch_size = 2;
+    options.queue_capacity = 1;
+    return options;
+  }
+
+  /** Parses an input serially, returning the expressions and the error message, if any. */
+  static vector<unique_ptr<const expression>> parse_serial(const string& input, string& error)
+  {
+    vector<unique_ptr<const expression>> expressions;
+    try
+    {
+      lexical_analyzer lex(input);
+      syntax_analyzer syn(lex);
+      while (auto expr = syn.next_expression())
+        expressions.push_back(move(expr));
+    }
+    catch (const exception& ex)
+    {
+      error = ex.what();
+    }
+    return expressions;
+  }
+
+  /** Verifies that the pipeline consumes the same expressions and throws the same error. */
+  static void verify(const string& input, const pipeline_options& options)
+  {
+    string expected_error;
+    auto expected = parse_serial(input, expected_error);
+
+    string error;
+    vector<unique_ptr<const expression>> expressions;
+    try
+    {
+      parse_pipelined(input, [&] (unique_ptr<const expression> expr) {
+          expressions.push_back(move(expr));
+        }, options);
+    }
+    catch (const exception& ex)
+    {
+      error = ex.what();
+    }
+
+    EXPECT_EQ(error, expected_error) << input;
+    ASSERT_EQ(expressions.size(), expected.size()) << input;
+    for (size_t idx = 0; idx < expressions.size(); idx++)
+      EXPECT_TRUE(expressions_equal(*expressions[idx], *expected[idx]));
+  }
+
+};
+
+/**
+ * Verify that the pipeline consumes the same expressions as a serial loop.
+ */
+TEST_F(pipelined_parser_tests, parse)
+{
+  mt19937 rng(46);
+  string input;
+  for (int idx = 0; idx < 500; idx++)
+  {
+    auto value = to_string(uniform_int_distribution<int>(0, 999)(rng));
+    input += (idx % 2 == 0 ? "(" + value + " * (1 + 2))\n" : value + " ");
+  }
+
+  verify(input, pipeline_options());
+  verify(input, tiny_options());
+  verify("", tiny_options());
+}
+
+/**
+ * Verify that errors are reported in the same order as by a serial loop.
+ */
+TEST_F(pipelined_parser_tests, errors)
+{
+  for (const auto& options : { pipeline_options(), tiny_options() })
+  {
+    verify("(1 + 2) (3 * 4) (5 6) (7 % 8)", options);
+    verify("(1 + 2) (3 * 4) (5 / 6) (7 % 8)", options);
+    verify("(1 + 2) (3 * 4) (5 / 6) (7 * 8", options);
+    verify("(1 + 2) (3 * 4) (5 / 6) % (7 * 8)", options);
+  }
+}
+
+/**
+ * Verify that an exception thrown by the consumer stops the pipeline.
+ */
+TEST_F(pipelined_parser_tests, consumer_error)
+{
+  string input;
+  for (int idx = 0; idx < 10000; idx++)
+    input += "(1 + 2) ";
+
+  int count = 0;
+  EXPECT_THROW(parse_pipelined(input, [&] (unique_ptr<const expression>) {
+        if (++count == 10)
+          throw logic_error("Stop!");
+      }, tiny_options()), logic_error);
+  EXPECT_EQ(count, 10);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file	regex_ast_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/17
+ */
+
+/* -- Includes -- */
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "regex_ast.hpp"
+#include "regex_nfa.hpp"
+#include "regex_postfix.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns the postfix notation for the simplified form of a regular expression. */
+  string simplified(const string& regex)
+  {
+    return regex_to_simplified_postfix(regex);
+  }
+
+}
+
+/* -- Tests -- */
+
+/**
+ * Unit test for regular expression syntax trees.
+ */
+class regex_ast_tests : public Test
+{
+};
+
+/**
+ * Verify that a syntax tree is built with flattened concatenations and alternations.
+ */
+TEST_F(regex_ast_tests, parse)
+{
+  auto ast = regex_to_ast("ab(c|d|e)*f{2,3}");
+
+  ASSERT_EQ(ast->type(), regex_ast_type::concatenation);
+  ASSERT_EQ(ast->children().size(), 4u);
+  EXPECT_EQ(ast->children()[0]->type(), regex_ast_type::atom);
+  EXPECT_TRUE(ast->children()[0]->set().test('a'));
+
+  const auto& star = *ast->children()[2];
+  ASSERT_EQ(star.type(), regex_ast_type::kleene);
+  ASSERT_EQ(star.children().front()->type(), regex_ast_type::alternation);
+  EXPECT_EQ(star.children().front()->children().size(), 3u);
+
+  const auto& repetition = *ast->children()[3];
+  ASSERT_EQ(repetition.type(), regex_ast_type::repetition);
+  EXPECT_EQ(repetition.repetition().min, 2u);
+  EXPECT_EQ(repetition.repetition().max, 3u);
+}
+
+/**
+ * Verify that a syntax tree converts back to equivalent postfix notation.
+ */
+TEST_F(regex_ast_tests, postfix)
+{
+  EXPECT_EQ(ast_to_postfix(*regex_to_ast("ab|c*")), "ab.c*|");
+  EXPECT_EQ(ast_to_postfix(*regex_to_ast("(a+)?x{2,}y{3}z{1,4}")), "a+?x{2,}.y{3}.z{1,4}.");
+  EXPECT_EQ(ast_to_postfix(*regex_to_ast("[a-z]\\.")), "[a-z]\\x2e.");
+  EXPECT_TRUE(regex_ast_equal(*regex_to_ast("a(b|c)"), *regex_to_ast("a(b|c)")));
+  EXPECT_FALSE(regex_ast_equal(*regex_to_ast("a(b|c)"), *regex_to_ast("a(c|b)")));
+}
+
+/**
+ * Verify each of the simplification rewrites.
+ */
+TEST_F(regex_ast_tests, simplify)
+{
+  // nested repetition operators
+  EXPECT_EQ(simplified("(a*)*"), "a*");
+  EXPECT_EQ(simplified("((a+)?)+"), "a*");
+  EXPECT_EQ(simplified("(a?)?"), "a?");
+  EXPECT_EQ(simplified("a{0,1}b{1,}c{1}"), "a?b+.c.");
+
+  // common prefixes
+  EXPECT_EQ(simplified("abc|abd"), "ab.[cd].");
+  EXPECT_EQ(simplified("x(ab|ac)|xa"), "xa.[bc]?.");
+  EXPECT_EQ(simplified("ab|a"), "ab?.");
+  EXPECT_EQ(simplified("for|foreach|while"), "fo.r.ea.c.h.?.wh.i.l.e.|");
+  EXPECT_EQ(simplified("abcx|abcy|abcd"), "ab.c.[dxy].");
+
+  // single characters
+  EXPECT_EQ(simplified("a|b|[0-9]|c"), "[0-9a-c]");
+  EXPECT_EQ(simplified("(x|y)|(z|xy)"), "xy?.[yz]|");
+}
+
+/**
+ * Verify that deeply nested syntax trees can be built, compared, converted and destroyed.
+ */
+TEST_F(regex_ast_tests, deep_nesting)
+{
+  static const size_t DEPTH = 100000;
+
+  string regex = string(DEPTH, '(') + "a";
+  for (size_t idx = 0; idx < DEPTH; idx++)
+    regex += ")*";
+  regex += "b";
+
+  auto ast1 = regex_to_ast(regex);
+  auto ast2 = regex_to_ast(regex);
+  EXPECT_TRUE(regex_ast_equal(*ast1, *ast2));
+  EXPECT_EQ(ast_to_postfix(*ast1), "a" + string(DEPTH, '*') + "b.");
+  EXPECT_EQ(simplified(regex), "a*b.");
+}
+
+/**
+ * Verify that simplified expressions match the same strings as the originals.
+ */
+TEST_F(regex_ast_tests, equivalence)
+{
+  static const vector<string> REGEXES {
+    "abc|abd", "(a*)*b", "for|foreach|forward", "a|ab|abc", "(a|b)*a(a|b){2}", "x(y|z)+|xw",
+    "(ab|ac){2,3}", "(a?b?)*c"
+  };
+  static const vector<string> INPUTS {
+    "abc", "abd", "ab", "b", "aab", "for", "foreach", "forwa", "forward", "a", "abc", "bbaab",
+    "xyz", "xw", "x", "abac", "ababac", "c", "abbac", ""
+  };
+
+  for (const auto& regex : REGEXES)
+  {
+    auto nfa = postfix_to_nfa(simplified(regex));
+    for (const auto& input : INPUTS)
+    {
+      // compare against the unsimplified expression
+      EXPECT_EQ(regex_match(nfa, input), regex_match(regex, input)) << regex << " " << input;
+    }
+  }
+}
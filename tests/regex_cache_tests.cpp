@@ -0,0 +1,120 @@
+/**
+ * @file	regex_cache_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/19
+ */
+
+/* -- Includes -- */
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "regex_cache.hpp"
+#include "regex_nfa.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::regex_cache` class.
+ */
+class regex_cache_tests : public Test
+{
+};
+
+/**
+ * Verify that repeated lookups return the cached NFA and update the counters.
+ */
+TEST_F(regex_cache_tests, hits_and_misses)
+{
+  regex_cache cache(4);
+
+  auto nfa1 = cache.get("a(b|c)*");
+  auto nfa2 = cache.get("a(b|c)*");
+  auto nfa3 = cache.get("x+");
+
+  EXPECT_EQ(nfa1, nfa2);
+  EXPECT_NE(nfa1, nfa3);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_EQ(cache.misses(), 2u);
+  EXPECT_TRUE(regex_match(*nfa1, "abcb"));
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.hits(), 0u);
+  EXPECT_EQ(cache.misses(), 0u);
+}
+
+/**
+ * Verify that the least recently used NFA is discarded when the cache is full.
+ */
+TEST_F(regex_cache_tests, eviction)
+{
+  regex_cache cache(2);
+
+  auto a = cache.get("a");
+  auto b = cache.get("b");
+  EXPECT_EQ(cache.get("a"), a);     // "b" is now least recently used
+  cache.get("c");                   // discards "b"
+
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.get("a"), a);
+  EXPECT_NE(cache.get("b"), b);     // recompiled, discarding "c"
+  EXPECT_EQ(cache.misses(), 4u);
+
+  cache.set_capacity(1);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.capacity(), 1u);
+
+  cache.set_capacity(0);
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_NE(cache.get("a"), cache.get("a"));
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+/**
+ * Verify that invalid regular expressions are not cached.
+ */
+TEST_F(regex_cache_tests, invalid)
+{
+  regex_cache cache;
+
+  EXPECT_THROW(cache.get("a("), runtime_error);
+  EXPECT_THROW(cache.get("a("), runtime_error);
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.misses(), 2u);
+}
+
+/**
+ * Verify that the cache may be used by several threads at once.
+ */
+TEST_F(regex_cache_tests, threads)
+{
+  static const vector<string> REGEXES { "a+b", "(ab)*", "[0-9]{2,3}", "x|y|z", "a?b?c?" };
+  static const size_t THREADS = 4;
+  static const size_t LOOKUPS = 1000;
+
+  regex_cache cache(3);
+  vector<thread> threads;
+  for (size_t id = 0; id < THREADS; id++)
+  {
+    threads.emplace_back([&, id] () {
+        for (size_t count = 0; count < LOOKUPS; count++)
+          cache.get(REGEXES[(id + count) % REGEXES.size()]);
+      });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(cache.hits() + cache.misses(), THREADS * LOOKUPS);
+  EXPECT_LE(cache.size(), 3u);
+}
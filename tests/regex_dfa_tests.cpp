@@ -0,0 +1,180 @@
+/**
+ * @file	regex_dfa_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/04
+ */
+
+/* -- Includes -- */
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "regex_dfa.hpp"
+#include "regex_dfa_file.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for generating DFAs from regular expressions.
+ */
+class regex_dfa_tests : public Test
+{
+protected:
+
+  /** Returns the tag of the state reached by running the DFA over the entire string. */
+  regex_dfa::tag_type final_tag(const regex_dfa& dfa, const string& str)
+  {
+    auto state = dfa.start();
+    for (auto ch : str)
+      state = dfa.next(state, static_cast<unsigned char>(ch));
+    return dfa.tag(state);
+  }
+
+  /** Returns a path for a temporary file. */
+  string temp_path(const string& name)
+  {
+    return TempDir() + name;
+  }
+
+};
+
+/**
+ * Verify that a DFA matches the same strings as the equivalent NFA.
+ */
+TEST_F(regex_dfa_tests, match)
+{
+  auto dfa = regex_to_dfa("(abc|d+e)(xyz?|123)");
+
+  EXPECT_TRUE(regex_match(dfa, "abcxyz"));
+  EXPECT_TRUE(regex_match(dfa, "abcxy"));
+  EXPECT_TRUE(regex_match(dfa, "dexyz"));
+  EXPECT_TRUE(regex_match(dfa, "ddde123"));
+  EXPECT_FALSE(regex_match(dfa, "abc"));
+  EXPECT_FALSE(regex_match(dfa, "abx"));
+  EXPECT_FALSE(regex_match(dfa, "e123"));
+}
+
+/**
+ * Verify that bytes which are not distinguished by any transition share a byte class.
+ */
+TEST_F(regex_dfa_tests, byte_classes)
+{
+  auto nfa1 = regex_to_nfa("ab+");
+  auto nfa2 = regex_to_nfa("b|c");
+  auto classes = nfa_byte_classes({ &nfa1, &nfa2 });
+
+  ASSERT_EQ(classes.size(), regex_dfa::alphabet_size);
+  EXPECT_NE(classes['a'], classes['b']);
+  EXPECT_NE(classes['b'], classes['c']);
+  EXPECT_NE(classes['a'], classes['x']);
+  EXPECT_EQ(classes['x'], classes['y']);
+  EXPECT_EQ(classes[0], classes[255]);
+
+  auto dfa = nfa_to_dfa({ &nfa1, &nfa2 });
+  EXPECT_EQ(dfa.class_count(), 4u);
+  EXPECT_TRUE(dfa.is_dead(dfa.next(dfa.start(), 'x')));
+  EXPECT_TRUE(dfa.is_dead(dfa.next(dfa.start(), 0xff)));
+}
+
+/**
+ * Verify that a character class needs only one byte class, however many bytes it contains.
+ */
+TEST_F(regex_dfa_tests, character_class_byte_classes)
+{
+  auto dfa = regex_to_dfa("[a-z_][a-z0-9_]*");
+
+  EXPECT_EQ(dfa.class_count(), 3u);
+  EXPECT_TRUE(regex_match(dfa, "snake_case9"));
+  EXPECT_FALSE(regex_match(dfa, "9lives"));
+}
+
+/**
+ * Verify that the dead state is state 0 and that it loops back to itself.
+ */
+TEST_F(regex_dfa_tests, dead_state)
+{
+  auto dfa = regex_to_dfa("ab");
+
+  EXPECT_FALSE(dfa.is_dead(dfa.start()));
+  auto state = dfa.next(dfa.start(), 'x');
+  EXPECT_TRUE(dfa.is_dead(state));
+  EXPECT_TRUE(dfa.is_dead(dfa.next(state, 'a')));
+  EXPECT_EQ(dfa.tag(state), regex_dfa::no_tag);
+}
+
+/**
+ * Verify that states are tagged with the index of the lowest pattern they accept.
+ */
+TEST_F(regex_dfa_tests, tags)
+{
+  auto dfa = regexes_to_dfa({ "if", "(a|b|f|i)+", "0+" });
+
+  EXPECT_EQ(final_tag(dfa, "if"), 0);
+  EXPECT_EQ(final_tag(dfa, "i"), 1);
+  EXPECT_EQ(final_tag(dfa, "iff"), 1);
+  EXPECT_EQ(final_tag(dfa, "000"), 2);
+  EXPECT_EQ(final_tag(dfa, "0a"), regex_dfa::no_tag);
+}
+
+/**
+ * Verify that a DFA can be written to a file and loaded back.
+ */
+TEST_F(regex_dfa_tests, save_and_load)
+{
+  auto path = temp_path("regex_dfa_tests_save_and_load.dfa");
+  auto original = regexes_to_dfa({ "if", "(a|b|f|i)+", "0+" });
+  save_regex_dfa(original, path);
+  auto loaded = load_regex_dfa(path);
+  remove(path.c_str());
+
+  ASSERT_EQ(loaded.state_count(), original.state_count());
+  ASSERT_EQ(loaded.class_count(), original.class_count());
+  ASSERT_EQ(loaded.start(), original.start());
+  for (regex_dfa::state_type state = 0; state < original.state_count(); state++)
+  {
+    EXPECT_EQ(loaded.tag(state), original.tag(state));
+    for (size_t ch = 0; ch < regex_dfa::alphabet_size; ch++)
+      EXPECT_EQ(loaded.next(state, ch), original.next(state, ch));
+  }
+
+  EXPECT_EQ(final_tag(loaded, "if"), 0);
+  EXPECT_EQ(final_tag(loaded, "fib"), 1);
+  EXPECT_EQ(final_tag(loaded, "00"), 2);
+}
+
+/**
+ * Verify that loading a file which is not a valid precompiled DFA fails.
+ */
+TEST_F(regex_dfa_tests, load_invalid)
+{
+  auto path = temp_path("regex_dfa_tests_load_invalid.dfa");
+  {
+    ofstream file(path, ios::binary | ios::trunc);
+    file << string(512, 'x');
+  }
+
+  EXPECT_THROW(load_regex_dfa(path), runtime_error);
+  remove(path.c_str());
+
+  EXPECT_THROW(load_regex_dfa(path), runtime_error);
+
+  // a transition to a state which does not exist
+  save_regex_dfa(regexes_to_dfa({ "ab" }), path);
+  {
+    fstream file(path, ios::binary | ios::in | ios::out);
+    file.seekp(32 + regex_dfa::alphabet_size);
+    regex_dfa::state_type state = 1000;
+    file.write(reinterpret_cast<const char*>(&state), sizeof(state));
+  }
+  EXPECT_THROW(load_regex_dfa(path), runtime_error);
+  remove(path.c_str());
+}
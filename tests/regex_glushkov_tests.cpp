@@ -0,0 +1,142 @@
+/**
+ * @file	regex_glushkov_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/15
+ */
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "regex_bit_parallel.hpp"
+#include "regex_glushkov.hpp"
+#include "regex_nfa.hpp"
+#include "regex_options.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for Glushkov automata.
+ */
+class regex_glushkov_tests : public Test
+{
+};
+
+/**
+ * Verify the positions of a simple automaton.
+ */
+TEST_F(regex_glushkov_tests, positions)
+{
+  // positions: a=0, b=1, c=2, d=3
+  auto glushkov = regex_to_glushkov("a(b|c)*d");
+
+  ASSERT_EQ(glushkov.size(), 4u);
+  EXPECT_TRUE(glushkov.positions()[1].test('b'));
+  EXPECT_EQ(glushkov.first(), (vector<size_t> { 0 }));
+  EXPECT_EQ(glushkov.last(), (vector<size_t> { 3 }));
+  EXPECT_EQ(glushkov.follow()[0], (vector<size_t> { 1, 2, 3 }));
+  EXPECT_EQ(glushkov.follow()[1], (vector<size_t> { 1, 2, 3 }));
+  EXPECT_EQ(glushkov.follow()[3], (vector<size_t> { }));
+  EXPECT_FALSE(glushkov.nullable());
+}
+
+/**
+ * Verify the positions of nullable and repeated expressions.
+ */
+TEST_F(regex_glushkov_tests, repetition)
+{
+  auto optional = regex_to_glushkov("a?b?");
+  EXPECT_EQ(optional.first(), (vector<size_t> { 0, 1 }));
+  EXPECT_EQ(optional.last(), (vector<size_t> { 0, 1 }));
+  EXPECT_TRUE(optional.nullable());
+
+  // x{2,3} is xx(x)?
+  auto bounded = regex_to_glushkov("x{2,3}");
+  ASSERT_EQ(bounded.size(), 3u);
+  EXPECT_EQ(bounded.first(), (vector<size_t> { 0 }));
+  EXPECT_EQ(bounded.last(), (vector<size_t> { 1, 2 }));
+  EXPECT_EQ(bounded.follow()[0], (vector<size_t> { 1 }));
+  EXPECT_EQ(bounded.follow()[1], (vector<size_t> { 2 }));
+
+  auto none = regex_to_glushkov("ab{0}c");
+  EXPECT_EQ(none.size(), 2u);
+  EXPECT_EQ(none.follow()[0], (vector<size_t> { 1 }));
+}
+
+/**
+ * Verify that the position limit is enforced.
+ */
+TEST_F(regex_glushkov_tests, position_limit)
+{
+  regex_options options;
+  options.max_fragments = 10;
+
+  EXPECT_NO_THROW(regex_to_glushkov("a{10}", options));
+  EXPECT_THROW(regex_to_glushkov("a{11}", options), runtime_error);
+  EXPECT_THROW(regex_to_glushkov("(ab){1000}{1000}", options), runtime_error);
+}
+
+/**
+ * Unit test for the `lexer::regex_bit_parallel` class.
+ */
+class regex_bit_parallel_tests : public Test
+{
+};
+
+/**
+ * Verify that the bit-parallel matcher matches the same strings as `lexer::regex_match`.
+ */
+TEST_F(regex_bit_parallel_tests, match)
+{
+  static const vector<string> REGEXES {
+    "abc", "a?bc", "a+b", "(ab|cd)*x", "[0-9]+\\.[0-9]*", "x{2,3}y", "(a|b)*a(a|b){3}",
+    "a{0}b", ".*z"
+  };
+  static const vector<string> INPUTS {
+    "abc", "bc", "aab", "b", "ababcdx", "x", "12.5", "12", "xxy", "xxxxy", "babab", "bbbb",
+    "b", "qqz", ""
+  };
+
+  for (const auto& regex : REGEXES)
+  {
+    regex_bit_parallel matcher(regex_to_glushkov(regex));
+    for (const auto& input : INPUTS)
+      EXPECT_EQ(matcher.match(input.data(), input.data() + input.size()), regex_match(regex, input))
+        << regex << " " << input;
+  }
+}
+
+/**
+ * Verify that Shift-And is used for sequences of atoms.
+ */
+TEST_F(regex_bit_parallel_tests, shift_and)
+{
+  EXPECT_TRUE(regex_bit_parallel(regex_to_glushkov("abc")).is_shift_and());
+  EXPECT_TRUE(regex_bit_parallel(regex_to_glushkov("a?b[0-9]c?")).is_shift_and());
+  EXPECT_FALSE(regex_bit_parallel(regex_to_glushkov("ab*c")).is_shift_and());
+  EXPECT_FALSE(regex_bit_parallel(regex_to_glushkov("a|b")).is_shift_and());
+}
+
+/**
+ * Verify that automata with too many positions are rejected.
+ */
+TEST_F(regex_bit_parallel_tests, too_large)
+{
+  regex_bit_parallel largest(regex_to_glushkov("a{63}b"));
+  string input(63, 'a');
+  EXPECT_FALSE(largest.match(input.data(), input.data() + input.size()));
+  input += "b";
+  EXPECT_TRUE(largest.match(input.data(), input.data() + input.size()));
+
+  EXPECT_THROW(regex_bit_parallel(regex_to_glushkov("a{64}b")), invalid_argument);
+}
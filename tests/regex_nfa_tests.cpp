@@ -6,10 +6,14 @@
 
 /* -- Includes -- */
 
+#include <chrono>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "regex_nfa.hpp"
+#include "regex_options.hpp"
 
 /* -- Namespaces -- */
 
@@ -78,6 +82,16 @@ protected:
     ASSERT_EQ(frag->is_terminal(), true);
   }
 
+  /** Returns the closure of the specified fragments, in the order it is visited. */
+  static vector<size_t> closure(const regex_nfa& nfa, vector<const regex_nfa_fragment*> entries)
+  {
+    vector<size_t> indices;
+    regex_nfa_closure closure(nfa);
+    for (const auto* entry : entries)
+      closure.add(entry, [&] (size_t index) { indices.push_back(index); });
+    return indices;
+  }
+
 };
 
 /**
@@ -246,6 +260,105 @@ TEST_F(regex_nfa_tests, repeat)
   assert_terminal(frag4);
 }
 
+/**
+ * Verifies that the generated NFA is correct for the "a[0-9]" regular expression.
+ *
+ *      a    [0-9]
+ *   0 ---> 1 ---> |2|
+ */
+TEST_F(regex_nfa_tests, character_class)
+{
+  auto nfa = regex_to_nfa("a[0-9]");
+
+  auto frag0 = nfa.head();
+  assert_valid_symbol_link(frag0->link1, 'a');
+  assert_invalid_link(frag0->link2);
+
+  auto frag1 = frag0->link1.output;
+  assert_valid_symbol_link(frag1->link1, regex_nfa_fragment::set_symbol);
+  assert_invalid_link(frag1->link2);
+  ASSERT_EQ(frag1->link1.set->count(), 10u);
+  ASSERT_TRUE(frag1->link1.matches('0'));
+  ASSERT_TRUE(frag1->link1.matches('9'));
+  ASSERT_FALSE(frag1->link1.matches('a'));
+
+  auto frag2 = frag1->link1.output;
+  assert_terminal(frag2);
+}
+
+/**
+ * Verifies that bounded repetition only needs one fragment per copy of the operand, plus one
+ * epsilon fragment per optional copy.
+ */
+TEST_F(regex_nfa_tests, bounded_repetition_size)
+{
+  ASSERT_EQ(regex_to_nfa("[0-9]{3}").fragments().size(), 4u);
+  ASSERT_EQ(regex_to_nfa("[0-9]{3,}").fragments().size(), 5u);
+  ASSERT_EQ(regex_to_nfa("[0-9]{1,10}").fragments().size(), 20u);
+}
+
+/**
+ * Verifies that NFAs larger than the configured limit are rejected.
+ */
+TEST_F(regex_nfa_tests, fragment_limit)
+{
+  regex_options options;
+  options.max_fragments = 50;
+
+  ASSERT_NO_THROW(regex_to_nfa("(ab){10}", options));
+  ASSERT_THROW(regex_to_nfa("(ab){30}", options), runtime_error);
+  ASSERT_THROW(regex_to_nfa("a{1000}{1000}"), runtime_error);
+}
+
+/**
+ * Verifies that epsilon closures contain only symbol and terminal fragments, in priority order.
+ */
+TEST_F(regex_nfa_tests, closure)
+{
+  // fragments: a=0, b=1, union=2, c=3, optional=4, terminal=5
+  auto nfa = regex_to_nfa("(a|b)c?");
+  const auto& fragments = nfa.fragments();
+
+  ASSERT_EQ(closure(nfa, { nfa.head() }), (vector<size_t> { 0, 1 }));
+  ASSERT_EQ(closure(nfa, { fragments[0]->link1.output }), (vector<size_t> { 3, 5 }));
+  ASSERT_EQ(closure(nfa, { fragments[3]->link1.output }), (vector<size_t> { 5 }));
+
+  // fragments already reached are not visited again until the closure is cleared
+  ASSERT_EQ(closure(nfa, { fragments[0]->link1.output, fragments[3]->link1.output }),
+            (vector<size_t> { 3, 5 }));
+
+  // nested loops of epsilon links must not be followed forever
+  auto nested = regex_to_nfa("(a*)*");
+  ASSERT_EQ(closure(nested, { nested.head() }).size(), 2u);
+}
+
+/**
+ * Verifies that building and matching NFAs full of epsilon links takes linear time. Storing the
+ * closure of every fragment made these take seconds (and gigabytes) rather than milliseconds.
+ */
+TEST_F(regex_nfa_tests, construction_time)
+{
+  static const size_t count = 20000;
+
+  regex_options options;
+  options.max_fragments = count * 8;
+
+  string stars;
+  for (size_t idx = 0; idx < count; idx++)
+    stars += "a*";
+  string nested = string(count, '(') + "a";
+  for (size_t idx = 0; idx < count; idx++)
+    nested += ")*b";
+
+  auto start = chrono::steady_clock::now();
+  auto stars_nfa = regex_to_nfa(stars, options);
+  auto nested_nfa = regex_to_nfa(nested, options);
+  EXPECT_TRUE(regex_match(stars_nfa, "aaaa"));
+  EXPECT_TRUE(regex_match(nested_nfa, "b"));
+  EXPECT_FALSE(regex_match(nested_nfa, "aa"));
+  EXPECT_LT(chrono::steady_clock::now() - start, chrono::seconds(2));
+}
+
 /**
  * Unit test for the `regex_match` method.
  */
@@ -455,6 +568,101 @@ TEST_F(regex_match_tests, word_alternation)
   EXPECT_FALSE(regex_match(REGEX, "namespcae"));
 }
 
+/**
+ * Verify that the `lexer::regex_match` function correctly matches character classes.
+ */
+TEST_F(regex_match_tests, character_class)
+{
+  static const string REGEX = "[a-c_][^a-z]+";
+
+  EXPECT_TRUE(regex_match(REGEX, "a0"));
+  EXPECT_TRUE(regex_match(REGEX, "_XY"));
+  EXPECT_TRUE(regex_match(REGEX, "c-"));
+  EXPECT_FALSE(regex_match(REGEX, "d0"));
+  EXPECT_FALSE(regex_match(REGEX, "ab"));
+  EXPECT_FALSE(regex_match(REGEX, "a"));
+}
+
+/**
+ * Verify that the `lexer::regex_match` function correctly matches class escape sequences.
+ */
+TEST_F(regex_match_tests, class_escapes)
+{
+  EXPECT_TRUE(regex_match("\\d+\\s\\w", "123 x"));
+  EXPECT_TRUE(regex_match("\\d+\\s\\w", "1\t_"));
+  EXPECT_FALSE(regex_match("\\d+\\s\\w", "x23 x"));
+  EXPECT_FALSE(regex_match("\\d+\\s\\w", "123x"));
+  EXPECT_TRUE(regex_match("\\D\\S\\W", "ab-"));
+  EXPECT_FALSE(regex_match("\\D\\S\\W", "1b-"));
+  EXPECT_TRUE(regex_match("[\\x41-\\x43]", "B"));
+  EXPECT_FALSE(regex_match("[\\x41-\\x43]", "D"));
+}
+
+/**
+ * Verify that the `lexer::regex_match` function correctly matches escaped operators.
+ */
+TEST_F(regex_match_tests, escaped_operators)
+{
+  static const string REGEX = "\\(a\\|b\\)\\*\\.";
+
+  EXPECT_TRUE(regex_match(REGEX, "(a|b)*."));
+  EXPECT_FALSE(regex_match(REGEX, "(a|b)*x"));
+  EXPECT_FALSE(regex_match(REGEX, "a"));
+}
+
+/**
+ * Verify that the `lexer::regex_match` function correctly matches the wildcard.
+ */
+TEST_F(regex_match_tests, any)
+{
+  static const string REGEX = "a.c";
+
+  EXPECT_TRUE(regex_match(REGEX, "abc"));
+  EXPECT_TRUE(regex_match(REGEX, "a.c"));
+  EXPECT_TRUE(regex_match(REGEX, "a\xff" "c"));
+  EXPECT_FALSE(regex_match(REGEX, "a\nc"));
+  EXPECT_FALSE(regex_match(REGEX, "ac"));
+}
+
+/**
+ * Verify that the `lexer::regex_match` function correctly matches bounded repetition.
+ */
+TEST_F(regex_match_tests, bounded_repetition)
+{
+  EXPECT_FALSE(regex_match("a{3}b", "aab"));
+  EXPECT_TRUE(regex_match("a{3}b", "aaab"));
+  EXPECT_FALSE(regex_match("a{3}b", "aaaab"));
+
+  EXPECT_FALSE(regex_match("x(ab){2,}y", "xaby"));
+  EXPECT_TRUE(regex_match("x(ab){2,}y", "xababy"));
+  EXPECT_TRUE(regex_match("x(ab){2,}y", "xabababy"));
+
+  EXPECT_FALSE(regex_match("x[0-9]{1,3}y", "xy"));
+  EXPECT_TRUE(regex_match("x[0-9]{1,3}y", "x1y"));
+  EXPECT_TRUE(regex_match("x[0-9]{1,3}y", "x123y"));
+  EXPECT_FALSE(regex_match("x[0-9]{1,3}y", "x1234y"));
+
+  EXPECT_TRUE(regex_match("x(a|b){0,2}y", "xy"));
+  EXPECT_TRUE(regex_match("x(a|b){0,2}y", "xbay"));
+  EXPECT_FALSE(regex_match("x(a|b){0,2}y", "xabay"));
+
+  EXPECT_TRUE(regex_match("xa{0}y", "xy"));
+  EXPECT_FALSE(regex_match("xa{0}y", "xay"));
+}
+
+/**
+ * Verify that the `lexer::regex_match` function handles nested repetitions, whose NFAs contain loops
+ * made only of epsilon links.
+ */
+TEST_F(regex_match_tests, nested_repetition)
+{
+  EXPECT_TRUE(regex_match("(a*)*b", "aaab"));
+  EXPECT_TRUE(regex_match("(a*)*b", "b"));
+  EXPECT_FALSE(regex_match("(a*)*b", "aaac"));
+  EXPECT_TRUE(regex_match("(a|b*)+c", "abbac"));
+  EXPECT_FALSE(regex_match("(a?)*x", "aaay"));
+}
+
 TEST_F(regex_match_tests, complex)
 {
   static const string REGEX = "(abc|d+e)(xyz?|123)";
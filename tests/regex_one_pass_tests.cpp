@@ -0,0 +1,126 @@
+/**
+ * @file	regex_one_pass_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/21
+ */
+
+/* -- Includes -- */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "regex_nfa.hpp"
+#include "regex_one_pass.hpp"
+#include "regex_options.hpp"
+#include "regex_pattern.hpp"
+#include "regex_pike_vm.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns the options for compiling with captures. */
+  regex_options capture_options()
+  {
+    regex_options options;
+    options.captures = true;
+    return options;
+  }
+
+}
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::regex_one_pass` class.
+ */
+class regex_one_pass_tests : public Test
+{
+};
+
+/**
+ * Verify that one-pass NFAs are detected.
+ */
+TEST_F(regex_one_pass_tests, detection)
+{
+  static const vector<string> ONE_PASS {
+    "([a-z]+)=([0-9]+)", "(a|b)c", "x(y)*z", "(ab)?c", "([0-9]+)(\\.[0-9]*)?", "a*"
+  };
+  static const vector<string> NOT_ONE_PASS {
+    "(a*)(a*)", "(a|ab)c", "(x+)x", "(a|b)*abb"
+  };
+
+  for (const auto& regex : ONE_PASS)
+    EXPECT_TRUE(nfa_to_one_pass(regex_to_nfa(regex, capture_options())) != nullptr) << regex;
+  for (const auto& regex : NOT_ONE_PASS)
+    EXPECT_TRUE(nfa_to_one_pass(regex_to_nfa(regex, capture_options())) == nullptr) << regex;
+}
+
+/**
+ * Verify that the one-pass DFA reports the same submatches as the Pike VM.
+ */
+TEST_F(regex_one_pass_tests, submatches)
+{
+  static const vector<string> REGEXES {
+    "([a-z]+)=([0-9]+)", "(a|b)c", "x(y)*z", "(ab)?c", "([0-9]+)(\\.[0-9]*)?", "a*", "((a)|b)+"
+  };
+  static const vector<string> INPUTS {
+    "", "key=42", "key=", "=1", "ac", "bcx", "xz", "xyyyz", "abc", "c", "12.5", "12", ".5", "aaa", "abab"
+  };
+
+  for (const auto& regex : REGEXES)
+  {
+    auto nfa = regex_to_nfa(regex, capture_options());
+    auto one_pass = nfa_to_one_pass(nfa);
+    ASSERT_TRUE(one_pass != nullptr) << regex;
+
+    regex_pike_vm vm(nfa);
+    for (const auto& input : INPUTS)
+    {
+      vector<regex_submatch> expected;
+      vector<regex_submatch> actual;
+      ASSERT_EQ(one_pass->match(input, actual), vm.match(input, expected)) << regex << " " << input;
+      ASSERT_EQ(actual.size(), expected.size());
+      for (size_t group = 0; group < expected.size(); group++)
+      {
+        EXPECT_EQ(actual[group].begin, expected[group].begin) << regex << " " << input << " " << group;
+        EXPECT_EQ(actual[group].end, expected[group].end) << regex << " " << input << " " << group;
+      }
+    }
+  }
+}
+
+/**
+ * Verify that matchers use the one-pass DFA when the pattern has one, and a Pike VM otherwise.
+ */
+TEST_F(regex_one_pass_tests, pattern)
+{
+  auto one_pass = regex_pattern::compile("([a-z]+)=([0-9]+)", capture_options());
+  auto not_one_pass = regex_pattern::compile("(a|ab)(c|bcd)", capture_options());
+  EXPECT_TRUE(one_pass->one_pass() != nullptr);
+  EXPECT_TRUE(not_one_pass->one_pass() == nullptr);
+
+  vector<regex_submatch> submatches;
+  regex_matcher matcher(one_pass);
+  ASSERT_TRUE(matcher.match("width=80;", submatches));
+  ASSERT_EQ(submatches.size(), 3u);
+  EXPECT_EQ(submatches[2].begin, 6u);
+  EXPECT_EQ(submatches[2].end, 8u);
+
+  matcher.reset(not_one_pass);
+  ASSERT_TRUE(matcher.match("abcd", submatches));
+  EXPECT_EQ(submatches[2].begin, 1u);
+  EXPECT_EQ(submatches[2].end, 4u);
+
+  matcher.reset(regex_pattern::compile("(a)b"));
+  EXPECT_THROW(matcher.match("ab", submatches), logic_error);
+}
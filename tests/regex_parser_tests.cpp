@@ -0,0 +1,115 @@
+/**
+ * @file	regex_parser_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/18
+ */
+
+/* -- Includes -- */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "regex_nfa.hpp"
+#include "regex_parser.hpp"
+#include "regex_postfix.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns the message of the exception thrown when parsing a regular expression. */
+  string parse_error(const string& regex)
+  {
+    try
+    {
+      parse_regex(regex);
+    }
+    catch (const runtime_error& ex)
+    {
+      return ex.what();
+    }
+    return string();
+  }
+
+  /** Returns the index of the fragment a link leads to, or -1 if it is not connected. */
+  long output_index(const regex_nfa_fragment* output)
+  {
+    return (output ? static_cast<long>(output->index) : -1);
+  }
+
+}
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::parse_regex` function.
+ */
+class regex_parser_tests : public Test
+{
+};
+
+/**
+ * Verify that the parser builds exactly the same NFA as the postfix notation.
+ */
+TEST_F(regex_parser_tests, same_nfa)
+{
+  static const vector<string> REGEXES {
+    "a", "abc", "a|b|c", "ab|cd*|e", "a?bc", "(a|b)*abb", "((a|b)c)+d?", "x(y|z){2,4}w",
+    "[a-z_][a-z0-9_]*", "\\d+\\.\\d*", ".*x.", "(a{2}|b{1,}){0,2}", "a**", "(((a)))"
+  };
+
+  for (const auto& regex : REGEXES)
+  {
+    auto parsed = parse_regex(regex);
+    auto expected = postfix_to_nfa(regex_to_postfix(regex));
+
+    ASSERT_EQ(parsed.fragments().size(), expected.fragments().size()) << regex;
+    EXPECT_EQ(parsed.head()->index, expected.head()->index) << regex;
+    for (size_t idx = 0; idx < parsed.fragments().size(); idx++)
+    {
+      const auto& frag = *parsed.fragments()[idx];
+      const auto& other = *expected.fragments()[idx];
+      EXPECT_EQ(frag.link1.symbol, other.link1.symbol) << regex << " " << idx;
+      EXPECT_EQ(frag.link2.symbol, other.link2.symbol) << regex << " " << idx;
+      EXPECT_EQ(output_index(frag.link1.output), output_index(other.link1.output)) << regex << " " << idx;
+      EXPECT_EQ(output_index(frag.link2.output), output_index(other.link2.output)) << regex << " " << idx;
+    }
+  }
+}
+
+/**
+ * Verify that syntax errors report the position of the problem.
+ */
+TEST_F(regex_parser_tests, errors)
+{
+  EXPECT_EQ(parse_error("ab(cd"), "Unmatched open bracket at position 2!");
+  EXPECT_EQ(parse_error("ab)cd"), "Unmatched close bracket at position 2!");
+  EXPECT_EQ(parse_error("a||b"), "Empty alternative at position 2!");
+  EXPECT_EQ(parse_error("a()"), "Empty alternative at position 2!");
+  EXPECT_EQ(parse_error("ab|"), "Empty alternative at position 3!");
+  EXPECT_EQ(parse_error(""), "Empty alternative at position 0!");
+  EXPECT_EQ(parse_error("a|*b"), "Nothing to repeat at position 2!");
+  EXPECT_EQ(parse_error("ab{2,1}"), "Invalid repetition operator at position 2!");
+  EXPECT_EQ(parse_error("a[bc"), "Unterminated character class at position 1!");
+}
+
+/**
+ * Verify that deeply nested groups do not exhaust the call stack.
+ */
+TEST_F(regex_parser_tests, deep_nesting)
+{
+  static const size_t DEPTH = 100000;
+
+  auto nfa = parse_regex(string(DEPTH, '(') + "a" + string(DEPTH, ')') + "b");
+  EXPECT_EQ(nfa.fragments().size(), 3u);
+  EXPECT_TRUE(regex_match(nfa, "ab"));
+}
@@ -0,0 +1,173 @@
+/**
+ * @file	regex_pattern_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/12
+ */
+
+/* -- Includes -- */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "regex_nfa.hpp"
+#include "regex_options.hpp"
+#include "regex_pattern.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for compiled patterns and matchers.
+ */
+class regex_pattern_tests : public Test
+{
+};
+
+/**
+ * Verify that a matcher matches the same strings as `lexer::regex_match`.
+ */
+TEST_F(regex_pattern_tests, match)
+{
+  static const string REGEX = "(abc|d+e)(xyz?|123)";
+  static const vector<string> INPUTS {
+    "abcxyz", "abcxy", "dexyz", "ddde123", "abc", "abx", "e123", ""
+  };
+
+  regex_matcher matcher(regex_pattern::compile(REGEX));
+  for (const auto& input : INPUTS)
+    EXPECT_EQ(matcher.match(input), regex_match(REGEX, input)) << input;
+}
+
+/**
+ * Verify that a matcher finds matches anywhere in a string.
+ */
+TEST_F(regex_pattern_tests, search)
+{
+  regex_matcher matcher(regex_pattern::compile("error[0-9]+"));
+
+  EXPECT_TRUE(matcher.search("xx error42 yy"));
+  EXPECT_TRUE(matcher.search("error error7"));
+  EXPECT_FALSE(matcher.search("error errorx"));
+  EXPECT_FALSE(matcher.search(""));
+}
+
+/**
+ * Verify that a matcher can be reset to use a different pattern.
+ */
+TEST_F(regex_pattern_tests, reset)
+{
+  regex_options options;
+  options.bit_parallel = false;
+
+  regex_matcher matcher(regex_pattern::compile("a+", options));
+  EXPECT_TRUE(matcher.match("aaa"));
+  EXPECT_GT(matcher.cached_states(), 1u);
+
+  auto pattern = regex_pattern::compile("b+", options);
+  matcher.reset(pattern);
+  EXPECT_EQ(matcher.pattern(), pattern);
+  EXPECT_FALSE(matcher.match("aaa"));
+  EXPECT_TRUE(matcher.match("bbb"));
+}
+
+/**
+ * Verify that a matcher keeps working when its DFA cache overflows.
+ */
+TEST_F(regex_pattern_tests, cache_overflow)
+{
+  // (a|b)*a(a|b){12} needs a DFA state for each of the 2^13 possible 13-character suffixes
+  regex_options options;
+  options.bit_parallel = false;
+  regex_matcher matcher(regex_pattern::compile("(a|b)*a(a|b){12}c", options));
+
+  string input;
+  for (int idx = 0; idx < 20000; idx++)
+    input.push_back((idx * 7 + idx / 3) % 5 < 2 ? 'a' : 'b');
+  EXPECT_FALSE(matcher.match(input));
+  EXPECT_TRUE(matcher.match(input + "abbbbbbbbbbbbc"));
+  EXPECT_LE(matcher.cached_states(), 4096u);
+}
+
+/**
+ * Verify that the bit-parallel matcher is only used for patterns which fit in a machine word.
+ */
+TEST_F(regex_pattern_tests, bit_parallel)
+{
+  auto small = regex_pattern::compile("(a|b)*a(a|b){12}c");
+  ASSERT_NE(small->bit_parallel(), nullptr);
+
+  regex_matcher matcher(small);
+  EXPECT_TRUE(matcher.match("babbbbbbbbbbbbcx"));
+  EXPECT_FALSE(matcher.match("bbbbbbbbbbbbbbc"));
+  EXPECT_TRUE(matcher.search("xxabbbbbbbbbbbbc"));
+  EXPECT_EQ(matcher.cached_states(), 2u);
+
+  auto large = regex_pattern::compile("(a|b)*a(a|b){70}c");
+  EXPECT_EQ(large->bit_parallel(), nullptr);
+}
+
+/**
+ * Verify that deeply nested regular expressions can be compiled.
+ */
+TEST_F(regex_pattern_tests, deep_nesting)
+{
+  static const size_t DEPTH = 100000;
+
+  string regex = string(DEPTH, '(') + "a";
+  for (size_t idx = 0; idx < DEPTH; idx++)
+    regex += ")*";
+  regex += "b";
+
+  regex_matcher matcher(regex_pattern::compile(regex));
+  EXPECT_TRUE(matcher.match("aaab"));
+  EXPECT_TRUE(matcher.match("b"));
+  EXPECT_FALSE(matcher.match("a"));
+}
+
+/**
+ * Verify that one pattern can be shared by many threads, each with its own matcher.
+ */
+TEST_F(regex_pattern_tests, concurrent_matching)
+{
+  static const int THREAD_COUNT = 8;
+  static const int ITERATIONS = 2000;
+  static const vector<pair<string, bool>> INPUTS {
+    { "id_42 = 7", true },
+    { "_x = 1234567", true },
+    { "9lives = 1", false },
+    { "name = ", false },
+    { "a=b", false },
+    { "abc = 12x", true },
+  };
+
+  auto pattern = regex_pattern::compile("[a-z_][a-z0-9_]* *= *[0-9]+");
+  atomic<int> failures { 0 };
+
+  vector<thread> threads;
+  for (int thread_idx = 0; thread_idx < THREAD_COUNT; thread_idx++)
+  {
+    threads.emplace_back([&, thread_idx] {
+        regex_matcher matcher(pattern);
+        for (int iteration = 0; iteration < ITERATIONS; iteration++)
+        {
+          const auto& input = INPUTS[(iteration + thread_idx) % INPUTS.size()];
+          if (matcher.match(input.first) != input.second)
+            failures++;
+          if (!matcher.search("line: " + input.first + "  ") && input.second)
+            failures++;
+        }
+      });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(failures.load(), 0);
+}
@@ -0,0 +1,146 @@
+/**
+ * @file	regex_pike_vm_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/20
+ */
+
+/* -- Includes -- */
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "regex_nfa.hpp"
+#include "regex_options.hpp"
+#include "regex_pike_vm.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns an NFA with captures for the specified regular expression. */
+  regex_nfa capture_nfa(const string& regex)
+  {
+    regex_options options;
+    options.captures = true;
+    return regex_to_nfa(regex, options);
+  }
+
+  /** Returns the submatches as (begin, end) pairs, with (-1, -1) for unmatched groups. */
+  vector<pair<long, long>> offsets(const vector<regex_submatch>& submatches)
+  {
+    vector<pair<long, long>> result;
+    for (const auto& submatch : submatches)
+    {
+      if (submatch.matched())
+        result.emplace_back(submatch.begin, submatch.end);
+      else
+        result.emplace_back(-1, -1);
+    }
+    return result;
+  }
+
+}
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::regex_pike_vm` class.
+ */
+class regex_pike_vm_tests : public Test
+{
+};
+
+/**
+ * Verify that the submatches for each group are reported.
+ */
+TEST_F(regex_pike_vm_tests, submatches)
+{
+  struct test_case
+  {
+    string regex;
+    string str;
+    vector<pair<long, long>> expected;
+  };
+  static const vector<test_case> TEST_CASES {
+    { "(a+)(b*)", "aaabbc", { { 0, 5 }, { 0, 3 }, { 3, 5 } } },
+    { "(a|ab)(c|bcd)", "abcd", { { 0, 4 }, { 0, 1 }, { 1, 4 } } },
+    { "(x)?y", "y", { { 0, 1 }, { -1, -1 } } },
+    { "(ab|c){2}", "abc", { { 0, 3 }, { 2, 3 } } },
+    { "((a)|b)+", "ab", { { 0, 2 }, { 1, 2 }, { 0, 1 } } },
+    { "a*", "b", { { 0, 0 } } },
+    { "(a*)*b", "aab", { { 0, 3 }, { 0, 2 } } },
+    { "([0-9]+)\\.([0-9]*)", "3.14!", { { 0, 4 }, { 0, 1 }, { 2, 4 } } },
+  };
+
+  for (const auto& test_case : TEST_CASES)
+  {
+    auto nfa = capture_nfa(test_case.regex);
+    vector<regex_submatch> submatches;
+    EXPECT_TRUE(regex_match(nfa, test_case.str, submatches)) << test_case.regex;
+    EXPECT_EQ(offsets(submatches), test_case.expected) << test_case.regex;
+  }
+}
+
+/**
+ * Verify that the VM agrees with `lexer::regex_match` on whether strings match.
+ */
+TEST_F(regex_pike_vm_tests, match)
+{
+  static const vector<string> REGEXES {
+    "abc", "(a|b)*abb", "x(y|z){2,4}w", "((a)b)+c?", "[a-c]?d", "(a|b?)b"
+  };
+  static const vector<string> INPUTS {
+    "", "abc", "ab", "aababb", "xyzw", "xyw", "xzzzzw", "ababc", "cd", "d", "b", "abx"
+  };
+
+  for (const auto& regex : REGEXES)
+  {
+    auto nfa = capture_nfa(regex);
+    regex_pike_vm vm(nfa);
+    for (const auto& input : INPUTS)
+    {
+      vector<regex_submatch> submatches;
+      EXPECT_EQ(vm.match(input, submatches), regex_match(regex, input)) << regex << " " << input;
+    }
+  }
+}
+
+/**
+ * Verify that NFAs without captures are matched without reporting any submatches.
+ */
+TEST_F(regex_pike_vm_tests, no_captures)
+{
+  auto nfa = regex_to_nfa("(ab)+");
+  EXPECT_EQ(nfa.slot_count(), 0u);
+
+  vector<regex_submatch> submatches;
+  EXPECT_TRUE(regex_match(nfa, "abab", submatches));
+  EXPECT_TRUE(submatches.empty());
+  EXPECT_FALSE(regex_match(nfa, "b", submatches));
+}
+
+/**
+ * Verify that long inputs are matched in linear time, without deep recursion.
+ */
+TEST_F(regex_pike_vm_tests, long_input)
+{
+  static const size_t LENGTH = 100000;
+
+  auto nfa = capture_nfa("((a|b)*)(c)");
+  auto str = string(LENGTH, 'a') + "c";
+
+  vector<regex_submatch> submatches;
+  ASSERT_TRUE(regex_match(nfa, str, submatches));
+  EXPECT_EQ(submatches[1].end, LENGTH);
+  EXPECT_EQ(submatches[2].begin, LENGTH - 1);
+  EXPECT_EQ(submatches[3].begin, LENGTH);
+}
@@ -6,6 +6,7 @@
 
 /* -- Includes -- */
 
+#include <stdexcept>
 #include <string>
 #include <gtest/gtest.h>
 
@@ -81,3 +82,58 @@ TEST_F(regex_postfix_tests, repeat)
   ASSERT_EQ(regex_to_postfix("ab+"), "ab+.");
   ASSERT_EQ(regex_to_postfix("ab+c"), "ab+.c.");
 }
+
+/**
+ * Verify that escape sequences and character classes are copied to the output as atoms.
+ */
+TEST_F(regex_postfix_tests, atoms)
+{
+  ASSERT_EQ(regex_to_postfix("[a-z]"), "[a-z]");
+  ASSERT_EQ(regex_to_postfix("[0-9]+x"), "[0-9]+x.");
+  ASSERT_EQ(regex_to_postfix("a[|.]b"), "a[|.].b.");
+  ASSERT_EQ(regex_to_postfix("\\d\\|"), "\\d\\|.");
+  ASSERT_EQ(regex_to_postfix("(\\*|\\()+"), "\\*\\(|+");
+}
+
+/**
+ * Verify that the wildcard is converted to the equivalent character class.
+ */
+TEST_F(regex_postfix_tests, any)
+{
+  ASSERT_EQ(regex_to_postfix("."), "[^\\n]");
+  ASSERT_EQ(regex_to_postfix("a.b"), "a[^\\n].b.");
+  ASSERT_EQ(regex_to_postfix(".*"), "[^\\n]*");
+}
+
+/**
+ * Verify that postfix notation containing atoms is converted back to a regular expression.
+ */
+TEST_F(regex_postfix_tests, atoms_to_regex)
+{
+  ASSERT_EQ(postfix_to_regex("[a-z]\\d+."), "[a-z]\\d+");
+  ASSERT_EQ(postfix_to_regex("[.|]\\.|"), "([.|]|\\.)");
+}
+
+/**
+ * Verify that bounded repetition operators are correctly converted to postfix notation.
+ */
+TEST_F(regex_postfix_tests, bounded_repetition)
+{
+  ASSERT_EQ(regex_to_postfix("a{3}"), "a{3}");
+  ASSERT_EQ(regex_to_postfix("a{2,}b"), "a{2,}b.");
+  ASSERT_EQ(regex_to_postfix("ab{1,10}"), "ab{1,10}.");
+  ASSERT_EQ(regex_to_postfix("(ab){0,2}c"), "ab.{0,2}c.");
+  ASSERT_EQ(postfix_to_regex("ab.{0,2}c."), "ab{0,2}c");
+}
+
+/**
+ * Verify that invalid bounded repetition operators are rejected.
+ */
+TEST_F(regex_postfix_tests, invalid_bounded_repetition)
+{
+  ASSERT_THROW(regex_to_postfix("a{"), runtime_error);
+  ASSERT_THROW(regex_to_postfix("a{,2}"), runtime_error);
+  ASSERT_THROW(regex_to_postfix("a{3,2}"), runtime_error);
+  ASSERT_THROW(regex_to_postfix("a{1x}"), runtime_error);
+  ASSERT_THROW(regex_to_postfix("a{99999999999}"), runtime_error);
+}
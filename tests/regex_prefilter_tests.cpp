@@ -0,0 +1,120 @@
+/**
+ * @file	regex_prefilter_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/10
+ */
+
+/* -- Includes -- */
+
+#include <string>
+#include <gtest/gtest.h>
+
+#include "regex_prefilter.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for extracting literal strings from regular expressions.
+ */
+class regex_prefilter_tests : public Test
+{
+protected:
+
+  /** Assert that the prefilter for a regular expression has the specified literals. */
+  void assert_literals(const string& regex, const string& prefix, const string& required)
+  {
+    auto prefilter = regex_to_prefilter(regex);
+    ASSERT_EQ(prefilter.prefix(), prefix) << regex;
+    ASSERT_EQ(prefilter.required(), required) << regex;
+  }
+
+};
+
+/**
+ * Verify that literal prefixes are extracted.
+ */
+TEST_F(regex_prefilter_tests, prefix)
+{
+  assert_literals("abc", "abc", "abc");
+  assert_literals("error(a|b)*", "error", "error");
+  assert_literals("ab+c", "ab", "ab");
+  assert_literals("abc|abd", "ab", "ab");
+  assert_literals("(ab){2,3}x", "ab", "abx");
+  assert_literals("a?bc", "", "bc");
+  assert_literals("[0-9]+", "", "");
+}
+
+/**
+ * Verify that required substrings are extracted when there is no prefix.
+ */
+TEST_F(regex_prefilter_tests, required)
+{
+  assert_literals("[a-z]+@example", "", "@example");
+  assert_literals("\\d*(foo|bar)baz", "", "baz");
+  assert_literals("x*(key|monkey)", "", "key");
+}
+
+/**
+ * Verify that candidate positions are found in a buffer.
+ */
+TEST_F(regex_prefilter_tests, find)
+{
+  regex_prefilter prefilter("ab", "cd");
+  string text = "xxabxxabcd";
+
+  EXPECT_EQ(prefilter.find_prefix(text.data(), text.size(), 0), 2u);
+  EXPECT_EQ(prefilter.find_prefix(text.data(), text.size(), 3), 6u);
+  EXPECT_EQ(prefilter.find_prefix(text.data(), text.size(), 7), regex_prefilter::npos);
+  EXPECT_EQ(prefilter.find_required(text.data(), text.size(), 0), 8u);
+  EXPECT_EQ(prefilter.find_required(text.data(), text.size(), 9), regex_prefilter::npos);
+}
+
+/**
+ * Unit test for the `regex_search` method.
+ */
+class regex_search_tests : public Test
+{
+};
+
+/**
+ * Verify that the `lexer::regex_search` function finds matches anywhere in the string.
+ */
+TEST_F(regex_search_tests, search)
+{
+  static const string REGEX = "error(a|b)*:";
+
+  EXPECT_TRUE(regex_search(REGEX, "error:"));
+  EXPECT_TRUE(regex_search(REGEX, "xx errorab: yy"));
+  EXPECT_TRUE(regex_search(REGEX, "errorx errorbba:"));
+  EXPECT_FALSE(regex_search(REGEX, "errorx error"));
+  EXPECT_FALSE(regex_search(REGEX, "erro:"));
+  EXPECT_FALSE(regex_search(REGEX, ""));
+}
+
+/**
+ * Verify that the `lexer::regex_search` function finds matches with a required substring.
+ */
+TEST_F(regex_search_tests, required)
+{
+  static const string REGEX = "[a-z]+@example";
+
+  EXPECT_TRUE(regex_search(REGEX, "mail chris@example now"));
+  EXPECT_FALSE(regex_search(REGEX, "mail @example now"));
+  EXPECT_FALSE(regex_search(REGEX, "mail chris@exampl"));
+}
+
+/**
+ * Verify that the `lexer::regex_search` function finds empty matches.
+ */
+TEST_F(regex_search_tests, empty)
+{
+  EXPECT_TRUE(regex_search("a*", ""));
+  EXPECT_TRUE(regex_search("a*", "bbb"));
+  EXPECT_TRUE(regex_search("x[0-9]*", "yyyx"));
+}
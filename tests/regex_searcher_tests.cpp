@@ -0,0 +1,137 @@
+/**
+ * @file	regex_searcher_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/23
+ */
+
+/* -- Includes -- */
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "regex_dfa.hpp"
+#include "regex_nfa.hpp"
+#include "regex_options.hpp"
+#include "regex_pike_vm.hpp"
+#include "regex_searcher.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Private Constants -- */
+
+namespace
+{
+
+  const vector<string> REGEXES {
+    "abc", "a+", "ab|bcdef", "(a|ab)(c|bcd)", "x*", "[0-9]+(\\.[0-9]+)?", "(ab)*c", "b?c|abcd"
+  };
+
+  const vector<string> INPUTS {
+    "", "abc", "xxabcxx", "baaab", "abcdef", "zabcd", "pi=3.14", "ababab", "abababc", "ccc", "bcd"
+  };
+
+}
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns `true` if the DFA matches the whole of the specified range. */
+  bool full_match(const regex_dfa& dfa, const char* begin, const char* end)
+  {
+    auto state = dfa.start();
+    for (auto it = begin; it != end; it++)
+      state = dfa.next(state, static_cast<unsigned char>(*it));
+    return (dfa.tag(state) != regex_dfa::no_tag);
+  }
+
+}
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::regex_searcher` class.
+ */
+class regex_searcher_tests : public Test
+{
+};
+
+/**
+ * Verify that a reversed NFA matches the reverse of the strings the original NFA matches.
+ */
+TEST_F(regex_searcher_tests, reverse_nfa)
+{
+  for (const auto& regex : REGEXES)
+  {
+    auto nfa = regex_to_nfa(regex);
+    auto reversed = reverse_nfa(nfa);
+    auto dfa = nfa_to_dfa({ &nfa });
+    auto reversed_dfa = nfa_to_dfa({ &reversed });
+
+    for (const auto& input : INPUTS)
+    {
+      string backwards(input.rbegin(), input.rend());
+      for (size_t len = 0; len <= input.size(); len++)
+      {
+        EXPECT_EQ(full_match(reversed_dfa, backwards.data(), backwards.data() + len),
+                  full_match(dfa, input.data() + input.size() - len, input.data() + input.size()))
+          << regex << " " << input << " " << len;
+      }
+    }
+  }
+}
+
+/**
+ * Verify that the searcher finds the same match as running the Pike VM from each position.
+ */
+TEST_F(regex_searcher_tests, search)
+{
+  regex_options options;
+  options.captures = true;
+
+  for (const auto& regex : REGEXES)
+  {
+    regex_searcher searcher(regex_to_nfa(regex));
+    auto nfa = regex_to_nfa(regex, options);
+    regex_pike_vm vm(nfa);
+
+    for (const auto& input : INPUTS)
+    {
+      // the leftmost-first match is the first match found starting from the left
+      bool expected = false;
+      regex_submatch expected_match { regex_submatch::npos, regex_submatch::npos };
+      vector<regex_submatch> submatches;
+      for (size_t pos = 0; !expected && pos <= input.size(); pos++)
+      {
+        if (vm.match(input.data() + pos, input.data() + input.size(), submatches))
+        {
+          expected = true;
+          expected_match = { pos + submatches[0].begin, pos + submatches[0].end };
+        }
+      }
+
+      regex_submatch match { regex_submatch::npos, regex_submatch::npos };
+      ASSERT_EQ(searcher.search(input, match), expected) << regex << " " << input;
+      EXPECT_EQ(match.begin, expected_match.begin) << regex << " " << input;
+      EXPECT_EQ(match.end, expected_match.end) << regex << " " << input;
+    }
+  }
+}
+
+/**
+ * Verify the convenience search function.
+ */
+TEST_F(regex_searcher_tests, regex_search)
+{
+  regex_submatch match;
+  ASSERT_TRUE(regex_search("[a-z]+[0-9]+", "123 abc42x", match));
+  EXPECT_EQ(match.begin, 4u);
+  EXPECT_EQ(match.end, 9u);
+  EXPECT_FALSE(regex_search("[a-z]+[0-9]+", "123 abc", match));
+}
@@ -0,0 +1,82 @@
+/**
+ * @file	regex_set_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/14
+ */
+
+/* -- Includes -- */
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "regex_nfa.hpp"
+#include "regex_set.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::regex_set` class.
+ */
+class regex_set_tests : public Test
+{
+};
+
+/**
+ * Verify that a set reports the same matches as `lexer::regex_match` for each pattern.
+ */
+TEST_F(regex_set_tests, match)
+{
+  static const vector<string> REGEXES {
+    "abc", "a+", "(ab|cd)*x", "[0-9]+", "a?bc", "x{2,3}y", ".*z"
+  };
+  static const vector<string> INPUTS {
+    "abc", "aaab", "ababx", "cdx", "x", "123", "bc", "xxy", "xyz", "", "q"
+  };
+
+  regex_set set(REGEXES);
+  ASSERT_EQ(set.size(), REGEXES.size());
+
+  for (const auto& input : INPUTS)
+  {
+    auto matched = set.match(input);
+    ASSERT_EQ(matched.size(), REGEXES.size());
+    for (size_t id = 0; id < REGEXES.size(); id++)
+      EXPECT_EQ(matched[id], regex_match(REGEXES[id], input)) << REGEXES[id] << " " << input;
+  }
+}
+
+/**
+ * Verify that the combined NFA tags each fragment with the pattern owning it.
+ */
+TEST_F(regex_set_tests, owners)
+{
+  regex_set set({ "a", "b", "c" });
+  const auto& fragments = set.nfa()->fragments();
+
+  vector<size_t> terminals;
+  for (const auto& frag : fragments)
+    if (frag->is_terminal())
+      terminals.push_back(set.owner(frag->index));
+  EXPECT_EQ(terminals, (vector<size_t> { 0, 1, 2 }));
+
+  EXPECT_EQ(set.match("b"), (vector<bool> { false, true, false }));
+}
+
+/**
+ * Verify that an empty set matches nothing.
+ */
+TEST_F(regex_set_tests, empty)
+{
+  regex_set set({ });
+
+  EXPECT_EQ(set.size(), 0u);
+  EXPECT_EQ(set.nfa(), nullptr);
+  EXPECT_TRUE(set.match("abc").empty());
+}
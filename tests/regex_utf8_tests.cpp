@@ -0,0 +1,193 @@
+/**
+ * @file	regex_utf8_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/22
+ */
+
+/* -- Includes -- */
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "regex_nfa.hpp"
+#include "regex_options.hpp"
+#include "regex_parser.hpp"
+#include "regex_pattern.hpp"
+#include "regex_set.hpp"
+#include "regex_utf8.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Private Procedures -- */
+
+namespace
+{
+
+  /** Returns the UTF-8 encoding of a code point. */
+  string encode(uint32_t cp)
+  {
+    string result;
+    if (cp < 0x80)
+      result.push_back(static_cast<char>(cp));
+    else if (cp < 0x800)
+    {
+      result.push_back(static_cast<char>(0xc0 | (cp >> 6)));
+      result.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+    }
+    else if (cp < 0x10000)
+    {
+      result.push_back(static_cast<char>(0xe0 | (cp >> 12)));
+      result.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+      result.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+    }
+    else
+    {
+      result.push_back(static_cast<char>(0xf0 | (cp >> 18)));
+      result.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3f)));
+      result.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+      result.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+    }
+    return result;
+  }
+
+  /** Returns `true` if any of the sequences matches the whole string. */
+  bool sequences_match(const vector<regex_utf8_sequence>& sequences, const string& str)
+  {
+    for (const auto& sequence : sequences)
+    {
+      if (sequence.size() != str.size())
+        continue;
+      bool match = true;
+      for (size_t idx = 0; match && idx < str.size(); idx++)
+        match = sequence[idx].test(static_cast<unsigned char>(str[idx]));
+      if (match)
+        return true;
+    }
+    return false;
+  }
+
+  /** Returns the options for UTF-8 regular expressions. */
+  regex_options utf8_options()
+  {
+    regex_options options;
+    options.utf8 = true;
+    return options;
+  }
+
+}
+
+/* -- Tests -- */
+
+/**
+ * Unit test for UTF-8 regular expressions.
+ */
+class regex_utf8_tests : public Test
+{
+};
+
+/**
+ * Verify that the byte sequences for code point ranges match exactly the code points in them.
+ */
+TEST_F(regex_utf8_tests, sequences)
+{
+  static const vector<vector<regex_code_point_range>> RANGES {
+    { { 0x3b1, 0x3c9 } },
+    { { 0x0, 0x9 }, { 0xb, 0x10ffff } },
+    { { 0x7f, 0x800 }, { 0xfff0, 0x10010 } },
+    { { 0x41, 0x5a }, { 0xd000, 0xe000 } },
+  };
+
+  for (const auto& ranges : RANGES)
+  {
+    auto sequences = utf8_sequences(ranges);
+    for (uint32_t cp = 0; cp <= 0x10ffff; cp++)
+    {
+      if (cp >= 0xd800 && cp <= 0xdfff)
+        continue;
+      bool expected = false;
+      for (const auto& range : ranges)
+        expected = expected || (cp >= range.low && cp <= range.high);
+      ASSERT_EQ(sequences_match(sequences, encode(cp)), expected) << cp;
+    }
+  }
+
+  // all ASCII ranges are merged into a single set
+  auto ascii = utf8_sequences({ { 'a', 'c' }, { 'x', 'z' }, { 0xe9, 0xe9 } });
+  ASSERT_EQ(ascii.size(), 2u);
+  EXPECT_EQ(ascii[0].size(), 1u);
+  EXPECT_EQ(ascii[0][0].count(), 6u);
+}
+
+/**
+ * Verify that UTF-8 regular expressions match whole code points.
+ */
+TEST_F(regex_utf8_tests, match)
+{
+  struct test_case
+  {
+    string regex;
+    string str;
+    bool expected;
+  };
+  static const vector<test_case> TEST_CASES {
+    { "a.b", "a€b", true },
+    { "a.b", "a\nb", false },
+    { "é+x", "ééx", true },
+    { "[α-ω]+_[0-9]", "λμ_1", true },
+    { "[α-ω]+_[0-9]", "Α_1", false },
+    { "[^a]b", "\U0001f600b", true },
+    { "[^a]b", "ab", false },
+    { "\\W\\w", "éa", true },
+    { "(café|naïve)!", "naïve!", true },
+  };
+
+  for (const auto& test_case : TEST_CASES)
+  {
+    auto nfa = parse_regex(test_case.regex, utf8_options());
+    EXPECT_EQ(regex_match(nfa, test_case.str), test_case.expected) << test_case.regex;
+
+    regex_matcher matcher(regex_pattern::compile(test_case.regex, utf8_options()));
+    EXPECT_EQ(matcher.match(test_case.str), test_case.expected) << test_case.regex;
+
+    regex_set set({ test_case.regex }, utf8_options());
+    EXPECT_EQ(set.match(test_case.str)[0], test_case.expected) << test_case.regex;
+  }
+}
+
+/**
+ * Verify that UTF-8 regular expressions are rewritten into equivalent byte regular expressions.
+ */
+TEST_F(regex_utf8_tests, to_bytes)
+{
+  EXPECT_EQ(regex_utf8_to_bytes("ab|c*"), "ab|c*");
+  EXPECT_EQ(regex_utf8_to_bytes("é+"), "(\\xc3\\xa9)+");
+  EXPECT_EQ(regex_utf8_to_bytes("x{2,3}[aé]"), "x{2,3}(a|\\xc3\\xa9)");
+}
+
+/**
+ * Verify that invalid UTF-8 is reported.
+ */
+TEST_F(regex_utf8_tests, errors)
+{
+  EXPECT_THROW(parse_regex("ab\xff", utf8_options()), runtime_error);
+  EXPECT_THROW(parse_regex("[\xc3]", utf8_options()), runtime_error);
+  EXPECT_THROW(parse_regex("\xed\xa0\x80", utf8_options()), runtime_error);
+  EXPECT_THROW(parse_regex("[ω-α]", utf8_options()), runtime_error);
+
+  try
+  {
+    parse_regex("ab\xc0\xaf", utf8_options());
+    FAIL();
+  }
+  catch (const runtime_error& ex)
+  {
+    EXPECT_STREQ(ex.what(), "Invalid UTF-8 sequence at position 2!");
+  }
+}
@@ -0,0 +1,243 @@
+/**
+ * @file	result_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/25
+ */
+
+/* -- Includes -- */
+
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "diagnostic.hpp"
+#include "expression.hpp"
+#include "lexical_analyzer.hpp"
+#include "regex_options.hpp"
+#include "regex_parser.hpp"
+#include "result.hpp"
+#include "syntax_analyzer.hpp"
+#include "token.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the non-throwing API returning `lexer::result`s.
+ */
+class result_tests : public Test
+{
+protected:
+
+  /** Returns the message of the exception thrown by parsing an input normally. */
+  static string exception_message(const string& input)
+  {
+    try
+    {
+      lexical_analyzer lex(input);
+      syntax_analyzer syn(lex);
+      while (syn.next_expression())
+        ;
+    }
+    catch (const exception& ex)
+    {
+      return ex.what();
+    }
+    return string();
+  }
+
+  /** Returns the message of the exception thrown by parsing a regular expression normally. */
+  static string regex_exception_message(const string& regex)
+  {
+    try
+    {
+      parse_regex(regex);
+    }
+    catch (const runtime_error& ex)
+    {
+      return ex.what();
+    }
+    return string();
+  }
+
+};
+
+/**
+ * Verify that a result holds either a value or an error.
+ */
+TEST_F(result_tests, value_or_error)
+{
+  result<unique_ptr<int>> value(make_unique<int>(42));
+  EXPECT_TRUE(value.ok());
+  EXPECT_TRUE(static_cast<bool>(value));
+  EXPECT_EQ(*value.value(), 42);
+
+  auto moved = move(value);
+  EXPECT_EQ(*moved.value(), 42);
+
+  result<unique_ptr<int>> error(diagnostic { diagnostic_kind::invalid_token, 3, 1, 0, 3 });
+  EXPECT_FALSE(error.ok());
+  EXPECT_EQ(error.error().offset, 3u);
+  EXPECT_THROW(error.value(), logic_error);
+
+  moved = move(error);
+  EXPECT_FALSE(moved.ok());
+  EXPECT_EQ(moved.error().kind, diagnostic_kind::invalid_token);
+}
+
+/**
+ * Verify that move assignment handles every combination of values and errors, and only destroys
+ * each value once.
+ */
+TEST_F(result_tests, move_assignment)
+{
+  static_assert(is_nothrow_move_constructible<result<unique_ptr<int>>>::value, "");
+  static_assert(is_nothrow_move_assignable<result<unique_ptr<int>>>::value, "");
+
+  auto first = make_shared<int>(1);
+  auto second = make_shared<int>(2);
+  diagnostic diag { diagnostic_kind::invalid_token, 3, 1, 0, 3 };
+
+  // value to value
+  result<shared_ptr<int>> target(first);
+  target = result<shared_ptr<int>>(second);
+  EXPECT_EQ(target.value(), second);
+  EXPECT_EQ(first.use_count(), 1);
+
+  // error to value
+  target = result<shared_ptr<int>>(diag);
+  EXPECT_FALSE(target.ok());
+  EXPECT_EQ(second.use_count(), 1);
+
+  // error to error
+  diag.offset = 7;
+  target = result<shared_ptr<int>>(diag);
+  EXPECT_EQ(target.error().offset, 7u);
+
+  // value to error
+  target = result<shared_ptr<int>>(first);
+  EXPECT_EQ(target.value(), first);
+  EXPECT_EQ(first.use_count(), 2);
+
+  // self assignment keeps the value
+  auto& self = target;
+  target = move(self);
+  EXPECT_EQ(target.value(), first);
+  EXPECT_EQ(first.use_count(), 2);
+}
+
+/**
+ * Verify that the lexer reports an invalid token without consuming it.
+ */
+TEST_F(result_tests, try_next_token)
+{
+  string input = "1 2\n %% 3";
+  lexical_analyzer lex(input);
+  EXPECT_EQ(lex.try_next_token().value().lexeme(), "1");
+  EXPECT_EQ(lex.try_next_token().value().lexeme(), "2");
+
+  for (int idx = 0; idx < 2; idx++)
+  {
+    auto tok = lex.try_next_token();
+    ASSERT_FALSE(tok.ok());
+    EXPECT_EQ(tok.error().kind, diagnostic_kind::invalid_token);
+    EXPECT_EQ(tok.error().offset, 5u);
+    EXPECT_EQ(tok.error().length, 2u);
+    EXPECT_EQ(tok.error().line_number, 1);
+    EXPECT_EQ(tok.error().column_number, 1);
+    EXPECT_EQ(diagnostic_message(tok.error(), input), exception_message(input));
+  }
+}
+
+/**
+ * Verify that the parser reports invalid expressions, preferring invalid tokens.
+ */
+TEST_F(result_tests, try_next_expression)
+{
+  string input = "(1 + 2) (3 4)";
+  lexical_analyzer lex(input);
+  syntax_analyzer syn(lex);
+
+  auto expr = syn.try_next_expression();
+  ASSERT_TRUE(expr.ok());
+  EXPECT_EQ(expr.value()->type(), expression_type::compound);
+
+  expr = syn.try_next_expression();
+  ASSERT_FALSE(expr.ok());
+  EXPECT_EQ(expr.error().kind, diagnostic_kind::unexpected_token);
+  EXPECT_EQ(expr.error().offset, 11u);
+  EXPECT_EQ(diagnostic_message(expr.error(), input), exception_message(input));
+
+  input = "(1 + $)";
+  lexical_analyzer bad_lex(input);
+  syntax_analyzer bad_syn(bad_lex);
+  expr = bad_syn.try_next_expression();
+  ASSERT_FALSE(expr.ok());
+  EXPECT_EQ(expr.error().kind, diagnostic_kind::invalid_token);
+  EXPECT_EQ(expr.error().offset, 5u);
+  EXPECT_EQ(diagnostic_message(expr.error(), input), exception_message(input));
+
+  // the end of the input is a null expression, as with `next_expression`
+  lexical_analyzer empty_lex("  ");
+  syntax_analyzer empty_syn(empty_lex);
+  expr = empty_syn.try_next_expression();
+  ASSERT_TRUE(expr.ok());
+  EXPECT_EQ(expr.value(), nullptr);
+}
+
+/**
+ * Verify that regular expression syntax errors are reported with the same messages as the
+ * exceptions.
+ */
+TEST_F(result_tests, try_parse_regex)
+{
+  EXPECT_TRUE(try_parse_regex("a(b|c)*").ok());
+
+  for (auto regex : { "ab(cd", "ab)cd", "a||b", "a()", "ab|", "", "a|*b",
+                      "a[bc", "[z-a]", "ab\\", "a\\xg1", "ab{2,1}", "a{1000000}", "(a){2" })
+  {
+    auto nfa = try_parse_regex(regex);
+    ASSERT_FALSE(nfa.ok()) << regex;
+    EXPECT_EQ(diagnostic_message(nfa.error(), regex), regex_exception_message(regex)) << regex;
+  }
+  EXPECT_EQ(try_parse_regex("ab(cd").error().kind, diagnostic_kind::regex_unmatched_open_bracket);
+  EXPECT_EQ(try_parse_regex("a|*b").error().kind, diagnostic_kind::regex_nothing_to_repeat);
+
+  // errors in atoms and repetitions have their own kinds too
+  auto nfa = try_parse_regex("a[bc");
+  ASSERT_FALSE(nfa.ok());
+  EXPECT_EQ(nfa.error().kind, diagnostic_kind::regex_unterminated_class);
+  EXPECT_EQ(nfa.error().offset, 1u);
+  EXPECT_EQ(diagnostic_message(nfa.error(), "a[bc"), "Unterminated character class at position 1!");
+  EXPECT_EQ(try_parse_regex("[z-a]").error().kind, diagnostic_kind::regex_invalid_class_range);
+  EXPECT_EQ(try_parse_regex("ab{2,1}").error().kind, diagnostic_kind::regex_invalid_repetition);
+  EXPECT_EQ(try_parse_regex("a{1000000}").error().kind,
+            diagnostic_kind::regex_repetition_too_large);
+
+  regex_options options;
+  options.utf8 = true;
+  nfa = try_parse_regex("a\xff", options);
+  ASSERT_FALSE(nfa.ok());
+  EXPECT_EQ(nfa.error().kind, diagnostic_kind::regex_invalid_utf8);
+  EXPECT_EQ(nfa.error().offset, 1u);
+  EXPECT_EQ(try_parse_regex("[^\\d\\D]", options).error().kind,
+            diagnostic_kind::regex_empty_class);
+
+  // only the size limit depends on the options
+  options = regex_options();
+  options.max_fragments = 10;
+  nfa = try_parse_regex("a{20}", options);
+  ASSERT_FALSE(nfa.ok());
+  EXPECT_EQ(nfa.error().kind, diagnostic_kind::regex_too_large);
+  EXPECT_EQ(diagnostic_message(nfa.error(), "a{20}"), "Regular expression is too large!");
+}
@@ -0,0 +1,84 @@
+/**
+ * @file	spsc_queue_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/22
+ */
+
+/* -- Includes -- */
+
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "spsc_queue.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::spsc_queue` class.
+ */
+class spsc_queue_tests : public Test
+{
+};
+
+/**
+ * Verify that the queue holds up to its capacity, in order, wrapping around its buffer.
+ */
+TEST_F(spsc_queue_tests, capacity)
+{
+  spsc_queue<int> queue(3);
+  EXPECT_EQ(queue.capacity(), 3u);
+
+  int item = 0;
+  EXPECT_FALSE(queue.try_pop(item));
+  for (int round = 0; round < 5; round++)
+  {
+    for (int idx = 0; idx < 3; idx++)
+    {
+      item = round * 10 + idx;
+      EXPECT_TRUE(queue.try_push(item));
+    }
+    item = -1;
+    EXPECT_FALSE(queue.try_push(item));
+    EXPECT_EQ(item, -1);
+
+    for (int idx = 0; idx < 3; idx++)
+    {
+      EXPECT_TRUE(queue.try_pop(item));
+      EXPECT_EQ(item, round * 10 + idx);
+    }
+    EXPECT_FALSE(queue.try_pop(item));
+  }
+}
+
+/**
+ * Verify that items pass from one thread to another intact and in order.
+ */
+TEST_F(spsc_queue_tests, threads)
+{
+  static const int count = 100000;
+  spsc_queue<int> queue(16);
+
+  thread producer([&] {
+      for (int idx = 0; idx < count; idx++)
+      {
+        int item = idx;
+        while (!queue.try_push(item))
+          this_thread::yield();
+      }
+    });
+
+  int item = 0;
+  for (int idx = 0; idx < count; idx++)
+  {
+    while (!queue.try_pop(item))
+      this_thread::yield();
+    ASSERT_EQ(item, idx);
+  }
+  producer.join();
+}
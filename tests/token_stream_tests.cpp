@@ -0,0 +1,106 @@
+/**
+ * @file	token_stream_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/23
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "lexical_analyzer.hpp"
+#include "token.hpp"
+#include "token_stream.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::token_stream` class.
+ */
+class token_stream_tests : public Test
+{
+};
+
+/**
+ * Verify that peeking looks ahead without consuming, and that references stay valid.
+ */
+TEST_F(token_stream_tests, peek)
+{
+  lexical_analyzer lex("(12 + 3)");
+  token_stream tokens(lex, 3);
+  EXPECT_EQ(tokens.lookahead(), 3u);
+
+  const auto& first = tokens.peek();
+  EXPECT_EQ(tokens.peek(2).lexeme(), "+");
+  EXPECT_EQ(tokens.peek(1).lexeme(), "12");
+  EXPECT_EQ(&tokens.peek(0), &first);
+  EXPECT_EQ(first.type(), token_type::open_bracket);
+  EXPECT_THROW(tokens.peek(3), out_of_range);
+
+  EXPECT_EQ(tokens.next().lexeme(), "(");
+  tokens.advance();
+  EXPECT_EQ(tokens.peek(2).lexeme(), ")");
+  EXPECT_EQ(tokens.next().lexeme(), "+");
+  EXPECT_EQ(tokens.next().lexeme(), "3");
+  EXPECT_EQ(tokens.next().lexeme(), ")");
+
+  // the end of the input is `eof` forever
+  EXPECT_EQ(tokens.peek(2).type(), token_type::eof);
+  EXPECT_EQ(tokens.next().type(), token_type::eof);
+  EXPECT_EQ(tokens.next().type(), token_type::eof);
+}
+
+/**
+ * Verify that the stream can be used as a range, which stops before `eof`.
+ */
+TEST_F(token_stream_tests, range)
+{
+  lexical_analyzer lex("(1 + (2 * 3))\n(4 / 5)");
+  token_stream tokens(lex);
+
+  vector<string> lexemes;
+  for (const auto& tok : tokens)
+  {
+    lexemes.push_back(tok.lexeme());
+    if (tok.lexeme() == "*")
+      break;
+  }
+  EXPECT_EQ(lexemes, (vector<string> { "(", "1", "+", "(", "2", "*" }));
+
+  // standard algorithms pick up where the loop left off, since the loop consumed its tokens up to
+  // (but not including) the one it broke on
+  EXPECT_EQ(tokens.next().lexeme(), "*");
+  auto brackets = count_if(tokens.begin(), tokens.end(), [] (const token& tok) {
+      return tok.type() == token_type::close_bracket;
+    });
+  EXPECT_EQ(brackets, 3);
+  EXPECT_EQ(tokens.begin(), tokens.end());
+
+  // postfix increment returns the token it consumed
+  lexical_analyzer lex2("1 2");
+  token_stream tokens2(lex2);
+  auto it = tokens2.begin();
+  EXPECT_EQ((*it++).lexeme(), "1");
+  EXPECT_EQ(it->lexeme(), "2");
+}
+
+/**
+ * Verify that invalid tokens are reported when they are first needed.
+ */
+TEST_F(token_stream_tests, errors)
+{
+  lexical_analyzer lex("1 %");
+  token_stream tokens(lex);
+  EXPECT_EQ(tokens.peek().lexeme(), "1");
+  EXPECT_THROW(tokens.peek(1), invalid_token_error);
+}
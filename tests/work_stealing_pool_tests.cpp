@@ -0,0 +1,74 @@
+/**
+ * @file	work_stealing_pool_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2017/02/21
+ */
+
+/* -- Includes -- */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "work_stealing_pool.hpp"
+
+/* -- Namespaces -- */
+
+using namespace std;
+using namespace testing;
+using namespace lexer;
+
+/* -- Tests -- */
+
+/**
+ * Unit test for the `lexer::work_stealing_pool` class.
+ */
+class work_stealing_pool_tests : public Test
+{
+};
+
+/**
+ * Verify that every task in a batch runs exactly once, over many batches.
+ */
+TEST_F(work_stealing_pool_tests, run)
+{
+  work_stealing_pool pool(4);
+  EXPECT_EQ(pool.thread_count(), 4u);
+
+  for (size_t count : { 0, 1, 3, 4, 100, 1000 })
+  {
+    vector<atomic<int>> calls(count);
+    for (auto& call : calls)
+      call = 0;
+
+    pool.run(count, [&] (size_t idx) { calls[idx]++; });
+    for (size_t idx = 0; idx < count; idx++)
+      EXPECT_EQ(calls[idx], 1) << "count " << count << ", task " << idx;
+  }
+}
+
+/**
+ * Verify that idle workers steal tasks from a worker which is stuck on a slow one.
+ */
+TEST_F(work_stealing_pool_tests, stealing)
+{
+  work_stealing_pool pool(2);
+  vector<thread::id> threads(100);
+
+  // task 0 is first in the first worker's queue, and blocks until the rest are done
+  atomic<size_t> done(0);
+  pool.run(threads.size(), [&] (size_t idx) {
+      if (idx == 0)
+      {
+        while (done != threads.size() - 1)
+          this_thread::sleep_for(chrono::milliseconds(1));
+      }
+      threads[idx] = this_thread::get_id();
+      if (idx != 0)
+        done++;
+    });
+
+  EXPECT_NE(threads[1], threads[0]);
+}